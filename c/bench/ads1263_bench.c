@@ -0,0 +1,257 @@
+/*****************************************************************************
+* | File        :   ads1263_bench.c
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 acquisition throughput benchmark
+* | Info        :
+*   Sweeps data rate, channel count and input mode through scan plans and
+*   reports achieved SPS, sample interval percentiles (CLOCK_MONOTONIC_RAW),
+*   CPU usage and CRC error rate for the backend this build uses.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include <stdlib.h>     //exit()
+#include <signal.h>     //signal()
+#include <time.h>
+#include <sys/resource.h>
+#include "ADS1263.h"
+#include "ADS1263_Scan.h"
+
+#define BENCH_MAXSAMPLE 20000
+
+static const char *RateName[16] = {
+    "2.5", "5", "10", "16.6", "20", "50", "60", "100",
+    "400", "1200", "2400", "4800", "7200", "14400", "19200", "38400",
+};
+
+static const char *FilterName[5] = {"sinc1", "sinc2", "sinc3", "sinc4", "FIR"};
+
+/* channel counts swept per mode: single-ended 0-10, differential 0-4 */
+static const UBYTE SingleCount[] = {1, 2, 5, 10};
+static const UBYTE DiffCount[] = {1, 2, 5};
+
+static uint64_t Interval[BENCH_MAXSAMPLE];
+static ADS1263_DEVICE Dev;
+static ADS1263_STATS Stats;
+static UBYTE ShowStats;
+
+void  Handler(int signo)
+{
+    //System Exit
+    printf("\r\n END \r\n");
+    DEV_Module_Exit();
+    exit(0);
+}
+
+static uint64_t Bench_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t Bench_CPU(void)
+{
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return (uint64_t)(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000000ULL
+        + (uint64_t)(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1000;
+}
+
+static int Bench_Cmp(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static double Bench_Pct(UDOUBLE Count, double p)
+{
+    if(Count == 0)
+        return 0;
+    return Interval[(UDOUBLE)(p * (Count - 1) + 0.5)] / 1000.0;
+}
+
+/******************************************************************************
+function:   Measure one point of the sweep
+parameter:
+    Mode   : 0 single-ended, 1 differential
+    Rate   : ADS1263_DRATE
+    Number : channels 0..Number-1
+    Max    : stop after this many samples
+    Budget : or after this many ns, whichever comes first
+Info:
+******************************************************************************/
+static void Bench_Point(UBYTE Mode, ADS1263_DRATE Rate, UBYTE Number, UDOUBLE Max, uint64_t Budget)
+{
+    ADS1263_SCAN_ENTRY Entry[ADS1263_SCAN_MAXSTEP];
+    ADS1263_SAMPLE Sample[ADS1263_SCAN_MAXSTEP];
+    ADS1263_SCAN_PLAN Plan;
+    UDOUBLE Count = 0, Intervals = 0, CrcErr = 0, Timeout = 0, Late = 0;
+    uint64_t t0, t1, c0, c1, Last = 0;
+    UBYTE i;
+
+    for(i = 0; i < Number; i++) {
+        Entry[i].Type = Mode == 0 ? ADS1263_SCAN_SINGLE : ADS1263_SCAN_DIFF;
+        Entry[i].Channel = i;
+    }
+    if(ADS1263_ScanPlan_Build(&Dev, &Plan, Entry, Number) != 0)
+        return;
+
+    // MODE2 write restarts ADC1; one unmeasured pass lets the filter settle
+    ADS1263_WriteReg(&Dev, REG_MODE2, (ADS1263_GetReg(&Dev, REG_MODE2) & 0xf0) | Rate);
+    ADS1263_ScanPlan_RunSamples(&Dev, &Plan, Sample);
+    if(ShowStats) {
+        ADS1263_Stats_Init(&Stats);
+        ADS1263_SetStats(&Dev, &Stats);
+    }
+
+    t0 = Bench_Now();
+    c0 = Bench_CPU();
+    while(Count < Max && Bench_Now() - t0 < Budget) {
+        ADS1263_ScanPlan_RunSamples(&Dev, &Plan, Sample);
+        for(i = 0; i < Number; i++, Count++) {
+            if(Sample[i].Flags & ADS1263_SAMPLE_TIMEOUT) {
+                Timeout++;
+                Last = 0;
+                continue;
+            }
+            if(Sample[i].Flags & ADS1263_SAMPLE_CRC_ERR)
+                CrcErr++;
+            if(Sample[i].Flags & ADS1263_SAMPLE_LATE)
+                Late++;
+            if(Last != 0 && Intervals < BENCH_MAXSAMPLE)
+                Interval[Intervals++] = Sample[i].Time_ns - Last;
+            Last = Sample[i].Time_ns;
+        }
+    }
+    t1 = Bench_Now();
+    c1 = Bench_CPU();
+    ADS1263_SetStats(&Dev, NULL);
+
+    qsort(Interval, Intervals, sizeof(Interval[0]), Bench_Cmp);
+    printf("%-5s %6s %3d %6u %9.1f %9.1f %9.1f %9.1f %9.1f %5.1f %8.5f %5u %5u\r\n",
+        Mode == 0 ? "se" : "diff", RateName[Rate], Number, Count,
+        Count * 1e9 / (double)(t1 - t0),
+        Bench_Pct(Intervals, 0.5), Bench_Pct(Intervals, 0.9), Bench_Pct(Intervals, 0.99),
+        Intervals ? Interval[Intervals - 1] / 1000.0 : 0.0,
+        100.0 * (c1 - c0) / (double)(t1 - t0),
+        Count ? 100.0 * CrcErr / Count : 0.0, Timeout, Late);
+    if(ShowStats) {
+        ADS1263_STATS_SNAPSHOT Snap;
+        ADS1263_Stats_Snapshot(&Stats, &Snap);
+        ADS1263_Stats_Print(stdout, &Snap);
+    }
+    fflush(stdout);
+}
+
+static void Bench_Usage(const char *Name)
+{
+    printf("Usage: %s [-n samples] [-t seconds] [-r rate] [-m mode] [-c channels] [-f filter] [-P] [-s]\r\n", Name);
+    printf("  -n  samples per point, default 2000, at most %d\r\n", BENCH_MAXSAMPLE);
+    printf("  -t  time limit per point in seconds, default 2\r\n");
+    printf("  -r  only this ADS1263_DRATE index, 0 (2.5SPS) - 15 (38400SPS)\r\n");
+    printf("  -m  only this mode, 0 single-ended, 1 differential\r\n");
+    printf("  -c  only this channel count, 1-10 (differential 1-5)\r\n");
+    printf("  -f  ADS1263_FILTER, 0-3 sinc1-sinc4, 4 FIR (default)\r\n");
+    printf("  -P  pipelined mux switching (ADS1263_ScanPlan_SetPipeline)\r\n");
+    printf("  -s  per-stage latency breakdown after each point (ADS1263_SetStats)\r\n");
+}
+
+int main(int argc, char **argv)
+{
+    UDOUBLE Max = 2000;
+    double Seconds = 2;
+    int Rate = -1, Mode = -1, Channels = -1, Pipeline = 0, Filter = ADS1263_FIR;
+    ADS1263_ADC1_CONFIG Config;
+    const UBYTE *Counts;
+    UBYTE Only, m, n, k;
+    int opt, r;
+
+    while((opt = getopt(argc, argv, "n:t:r:m:c:f:Psh")) != -1) {
+        switch(opt) {
+        case 'n': Max = strtoul(optarg, NULL, 0); break;
+        case 't': Seconds = atof(optarg); break;
+        case 'r': Rate = atoi(optarg); break;
+        case 'm': Mode = atoi(optarg); break;
+        case 'c': Channels = atoi(optarg); break;
+        case 'f': Filter = atoi(optarg); break;
+        case 'P': Pipeline = 1; break;
+        case 's': ShowStats = 1; break;
+        default:
+            Bench_Usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if(Max == 0 || Max > BENCH_MAXSAMPLE || Rate > 15 || Mode > 1 || Channels == 0 || Channels > 10 || Filter < 0 || Filter > ADS1263_FIR) {
+        Bench_Usage(argv[0]);
+        return 1;
+    }
+
+    // Exception handling:ctrl + c
+    signal(SIGINT, Handler);
+
+    if(DEV_Module_Init() != 0) {
+        printf("DEV_Module_Init failed. Exiting.\r\n");
+        return 1;
+    }
+    ADS1263_Device_Init(&Dev, &DEV_Port0);
+    ADS1263_ADC1_DefaultConfig(&Config, ADS1263_38400SPS);
+    Config.Filter = (ADS1263_FILTER)Filter;
+    if(ADS1263_init_ADC1_Config(&Dev, &Config) == 1) {
+        DEV_Module_Exit();
+        return 1;
+    }
+    ADS1263_ScanPlan_SetPipeline(&Dev, Pipeline);
+
+    printf("backend: %s, DRDY: %s, pipeline: %s, filter: %s\r\n", DEV_Backend(),
+        DEV_GPIO_EVENT_IsOpen(&DEV_Port0.DRDY) ? "events" : "polled", Pipeline ? "on" : "off",
+        FilterName[Filter]);
+    printf("%-5s %6s %3s %6s %9s %9s %9s %9s %9s %5s %8s %5s %5s\r\n",
+        "mode", "SPS", "ch", "n", "achieved", "p50(us)", "p90(us)", "p99(us)", "max(us)",
+        "cpu%", "crc%", "tmo", "late");
+
+    for(m = 0; m < 2; m++) {
+        if(Mode >= 0 && m != Mode)
+            continue;
+        ADS1263_SetMode(&Dev, m);
+        Counts = m == 0 ? SingleCount : DiffCount;
+        n = m == 0 ? sizeof(SingleCount) : sizeof(DiffCount);
+        if(Channels > 0) {
+            if(m == 1 && Channels > 5)
+                continue;
+            Only = Channels;
+            Counts = &Only;
+            n = 1;
+        }
+        for(r = 0; r < 16; r++) {
+            if(Rate >= 0 && r != Rate)
+                continue;
+            for(k = 0; k < n; k++) {
+                Bench_Point(m, (ADS1263_DRATE)r, Counts[k], Max, (uint64_t)(Seconds * 1e9));
+            }
+        }
+    }
+
+    DEV_Module_Exit();
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*****************************************************************************
+* | File        :   ads1263_net.h
+* | Author      :   Waveshare team
+* | Function    :   ads1263d wire format
+* | Info        :
+*   Batched binary frames the acquisition daemon sends over TCP and UDP,
+*   and the shared-memory ring it fills for local consumers. Everything is
+*   little-endian, the byte order of the Pi and Jetson the daemon runs on.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_NET_H_
+#define _ADS1263_NET_H_
+
+#include <stdint.h>
+
+#define ADS1263_NET_MAGIC       0x31534441      // "ADS1"
+#define ADS1263_NET_VERSION     1
+#define ADS1263_NET_PORT        5263            // default TCP port
+
+/* ADS1263_NET_HEADER.Type */
+#define ADS1263_NET_DATA        0               // Count records follow
+#define ADS1263_NET_REPLY       1               // answer to one command, no records
+
+/* records per frame, so that a frame fits one 1500-byte Ethernet UDP datagram */
+#define ADS1263_NET_MAXREC      ((1472 - sizeof(ADS1263_NET_HEADER)) / sizeof(ADS1263_NET_RECORD))
+
+/**
+ * Sent ahead of every frame. Seq counts DATA frames and is shared by all
+ * transports, so a gap is a frame the daemon had to skip for this receiver
+ * or, over UDP, one the network lost
+**/
+typedef struct {
+    uint32_t Magic;         // ADS1263_NET_MAGIC
+    uint8_t Version;        // ADS1263_NET_VERSION
+    uint8_t Type;           // ADS1263_NET_xxx
+    uint16_t Count;         // records in this frame
+    uint32_t Seq;           // DATA: this frame; REPLY: first frame with the new settings
+    uint32_t Dropped;       // conversions lost to a full acquisition ring so far
+    uint32_t Board;         // daemon -b option, tells boards apart
+    uint8_t Rate;           // ADS1263_DRATE the records were taken at
+    uint8_t Mode;           // 0 single-ended, 1 differential
+    uint8_t Result;         // REPLY: 0 command applied, 1 rejected
+    uint8_t Reserved;
+} ADS1263_NET_HEADER;
+
+/**
+ * One conversion, laid out as ADS1263_SAMPLE so the daemon sends straight
+ * from the acquisition ring
+**/
+typedef struct {
+    uint64_t Time_ns;       // CLOCK_MONOTONIC_RAW of the daemon host
+    uint32_t Value;         // raw code, or the decimated value with the daemon -a option
+    uint8_t Channel;
+    uint8_t Status;         // status byte sent ahead of the data
+    uint8_t CRC;            // checksum byte sent after the data
+    uint8_t Flags;          // ADS1263_SAMPLE_CRC_ERR 0x01, _TIMEOUT 0x02, _LATE 0x04
+} ADS1263_NET_RECORD;
+
+/**
+ * Shared-memory ring, /dev/shm/<name> of the daemon -s option.
+ * Record n sits at Record[n % Size]. The daemon raises Claim before it
+ * overwrites records and Head once they are complete. Read Head with
+ * __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE), copy the records below
+ * it, then __atomic_thread_fence(__ATOMIC_ACQUIRE) and load Claim: records
+ * more than Size behind that value were overwritten while copying
+**/
+#define ADS1263_NET_SHM_MAGIC   0x52534441      // "ADSR"
+
+typedef struct {
+    uint32_t Magic;         // ADS1263_NET_SHM_MAGIC, written last
+    uint8_t Version;        // ADS1263_NET_VERSION
+    uint8_t Reserved[3];
+    uint32_t Size;          // records, a power of two
+    uint32_t Board;
+    _Alignas(64) uint64_t Head;     // records complete
+    uint64_t Claim;                 // records being written, >= Head
+    _Alignas(64) ADS1263_NET_RECORD Record[];
+} ADS1263_NET_SHM;
+
+#endif
@@ -0,0 +1,743 @@
+/*****************************************************************************
+* | File        :   ads1263d.c
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 acquisition daemon
+* | Info        :
+*   Streams ADC1 conversions to TCP clients, a UDP destination and a
+*   shared-memory ring as batched binary frames (ads1263_net.h), and takes
+*   RATE and SCAN commands from TCP clients to reconfigure the stream.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#define _GNU_SOURCE     // sendmmsg()
+#include <stdlib.h>     //exit()
+#include <signal.h>     //signal()
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <stddef.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "ADS1263.h"
+#include "ADS1263_Stream.h"
+#include "ADS1263_Decim.h"
+#include "ads1263_net.h"
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "ads1263_net.h frames are little-endian, records are sent as they sit in memory"
+#endif
+_Static_assert(sizeof(ADS1263_NET_RECORD) == sizeof(ADS1263_SAMPLE)
+    && offsetof(ADS1263_NET_RECORD, Value) == offsetof(ADS1263_SAMPLE, Value)
+    && offsetof(ADS1263_NET_RECORD, Flags) == offsetof(ADS1263_SAMPLE, Flags),
+    "ADS1263_NET_RECORD has to match ADS1263_SAMPLE");
+
+#define DAEMON_MAXCLIENT    8
+#define DAEMON_BATCH        16          // frames per sendmsg / sendmmsg
+#define DAEMON_LINE         128         // longest command line
+#define DAEMON_READ         256         // command bytes taken per recv
+#define DAEMON_RING         65536       // acquisition ring, samples
+#define DAEMON_SHMSIZE      65536       // shared-memory ring, records
+/* largest batch one client can be left holding part of, plus the replies
+   to the most commands one recv can carry */
+#define DAEMON_PEND         (DAEMON_BATCH * (sizeof(ADS1263_NET_HEADER) + ADS1263_NET_MAXREC * sizeof(ADS1263_NET_RECORD)) \
+                            + (DAEMON_READ / 2) * sizeof(ADS1263_NET_HEADER))
+
+typedef struct {
+    int Fd;                     // -1 free slot
+    char Line[DAEMON_LINE];     // command being received
+    UWORD LineLen;
+    UBYTE *Pend;                // tail of a batch the socket took only part of
+    UDOUBLE PendOff, PendLen;
+    UBYTE Reply;                // a reply waits in Pend, no commands are read
+    UDOUBLE Skipped;            // frames not sent while the client was backed up
+} DAEMON_CLIENT;
+
+static ADS1263_DEVICE Dev;
+static ADS1263_STREAM Stream;
+static ADS1263_DECIM Decim;
+static DAEMON_CLIENT Client[DAEMON_MAXCLIENT];
+static ADS1263_NET_SHM *Shm;
+static size_t ShmBytes;
+static char ShmName[64];
+static int Listen = -1, Udp = -1;
+static volatile sig_atomic_t Quit;
+
+/* what the stream currently runs with */
+static UBYTE Rate = ADS1263_1200SPS, Mode = 0, Number = 1;
+static UBYTE List[ADS1263_STREAM_MAXCH] = {0};
+static UDOUBLE Board, Records = 64, Seq, Dropped;
+
+/* one batch of frames, the records point into the acquisition ring */
+static ADS1263_NET_HEADER Hdr[DAEMON_BATCH];
+static struct iovec Iov[2 * DAEMON_BATCH];
+static struct mmsghdr Msg[DAEMON_BATCH];
+
+void  Handler(int signo)
+{
+    Quit = 1;
+}
+
+static uint64_t Daemon_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void Daemon_Header(ADS1263_NET_HEADER *H, UBYTE Type, UWORD Count, UBYTE Result)
+{
+    H->Magic = ADS1263_NET_MAGIC;
+    H->Version = ADS1263_NET_VERSION;
+    H->Type = Type;
+    H->Count = Count;
+    H->Seq = Seq;
+    H->Dropped = Dropped + ADS1263_Stream_Dropped(&Stream);
+    H->Board = Board;
+    H->Rate = Rate;
+    H->Mode = Mode;
+    H->Result = Result;
+    H->Reserved = 0;
+}
+
+/******************************************************************************
+function:   Parse a number of at most Max
+parameter:
+    Str : token, decimal or 0x hex
+Info:   Return 0 success, 1 not a number or out of range
+******************************************************************************/
+static UBYTE Daemon_Number(const char *Str, long Max, long *Out)
+{
+    char *End;
+    long v;
+    if(Str == NULL)
+        return 1;
+    errno = 0;
+    v = strtol(Str, &End, 0);
+    if(errno != 0 || End == Str || *End != '\0' || v < 0 || v > Max)
+        return 1;
+    *Out = v;
+    return 0;
+}
+
+/******************************************************************************
+function:   Parse a channel list, separated by commas or blanks
+parameter:
+    Str  : string to start on, NULL to go on with Save
+    Mode : 0 single-ended AIN0-AIN10, 1 differential pairs 0-4
+    Out  : ADS1263_STREAM_MAXCH channels
+Info:   Return the channel count, 0 on error
+******************************************************************************/
+static UBYTE Daemon_List(char *Str, char **Save, UBYTE Mode, UBYTE *Out)
+{
+    char *Tok;
+    long v;
+    UBYTE n = 0;
+    while((Tok = strtok_r(Str, " \t,", Save)) != NULL) {
+        Str = NULL;
+        if(n == ADS1263_STREAM_MAXCH || Daemon_Number(Tok, Mode ? 4 : 10, &v) != 0)
+            return 0;
+        Out[n++] = v;
+    }
+    return n;
+}
+
+/******************************************************************************
+function:   Close a client connection and free its slot
+******************************************************************************/
+static void Daemon_ClientClose(DAEMON_CLIENT *C)
+{
+    if(C->Fd < 0)
+        return;
+    printf("client %d closed, %u frames skipped \r\n", C->Fd, C->Skipped);
+    close(C->Fd);
+    free(C->Pend);
+    C->Fd = -1;
+    C->Pend = NULL;
+}
+
+/******************************************************************************
+function:   Send what is left of a partly sent batch
+Info:   Return 0 connection still open, 1 closed
+******************************************************************************/
+static UBYTE Daemon_ClientDrain(DAEMON_CLIENT *C)
+{
+    ssize_t r = send(C->Fd, C->Pend + C->PendOff, C->PendLen - C->PendOff, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if(r < 0) {
+        if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+        Daemon_ClientClose(C);
+        return 1;
+    }
+    C->PendOff += r;
+    if(C->PendOff == C->PendLen) {
+        C->PendOff = C->PendLen = 0;
+        C->Reply = 0;
+    }
+    return 0;
+}
+
+/******************************************************************************
+function:   Keep the unsent part of a message for Daemon_ClientDrain
+parameter:
+    Off : bytes of Iov the socket took already
+******************************************************************************/
+static void Daemon_ClientKeep(DAEMON_CLIENT *C, const struct iovec *Iov, int Count, size_t Off)
+{
+    size_t k;
+    int i;
+
+    for(i = 0; i < Count; i++) {
+        if(Off >= Iov[i].iov_len) {
+            Off -= Iov[i].iov_len;
+            continue;
+        }
+        k = Iov[i].iov_len - Off;
+        memcpy(C->Pend + C->PendLen, (const UBYTE *)Iov[i].iov_base + Off, k);
+        C->PendLen += k;
+        Off = 0;
+    }
+}
+
+/******************************************************************************
+function:   Send a batch of frames to one client
+parameter:
+    Iov    : header and record vectors of the batch
+    Count  : vectors
+    Frames : frames in the batch, 0 for a command reply
+Info:
+    Never blocks. A client whose socket is full loses whole batches, seen
+    as a Seq gap; the part of a batch the socket took only half of is kept
+    and sent first, so the byte stream always stays frame-aligned.
+    A reply is never lost: it is queued behind that part, and the client's
+    commands are not read until it has gone out.
+******************************************************************************/
+static void Daemon_ClientSend(DAEMON_CLIENT *C, const struct iovec *Iov, int Count, UDOUBLE Frames)
+{
+    struct msghdr m = {0};
+    size_t Total = 0;
+    ssize_t r;
+    int i;
+
+    if(C->PendLen > 0 && Daemon_ClientDrain(C) != 0)
+        return;
+    if(C->PendLen > 0) {
+        if(Frames == 0) {
+            Daemon_ClientKeep(C, Iov, Count, 0);
+            C->Reply = 1;
+        }
+        else {
+            C->Skipped += Frames;
+        }
+        return;
+    }
+    for(i = 0; i < Count; i++)
+        Total += Iov[i].iov_len;
+    m.msg_iov = (struct iovec *)Iov;
+    m.msg_iovlen = Count;
+    r = sendmsg(C->Fd, &m, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if(r < 0) {
+        if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            Daemon_ClientClose(C);
+            return;
+        }
+        if(Frames > 0) {
+            C->Skipped += Frames;
+            return;
+        }
+        r = 0;                  // a reply is kept whole
+    }
+    if((size_t)r < Total) {
+        Daemon_ClientKeep(C, Iov, Count, r);
+        if(Frames == 0)
+            C->Reply = 1;
+    }
+}
+
+/******************************************************************************
+function:   Copy a run of samples into the shared-memory ring
+******************************************************************************/
+static void Daemon_ShmWrite(const ADS1263_SAMPLE *Batch, UDOUBLE Count)
+{
+    uint64_t Head = Shm->Head;
+    UDOUBLE At, k;
+
+    __atomic_store_n(&Shm->Claim, Head + Count, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    while(Count > 0) {
+        At = Head & (Shm->Size - 1);
+        k = Shm->Size - At < Count ? Shm->Size - At : Count;
+        memcpy(&Shm->Record[At], Batch, k * sizeof(ADS1263_SAMPLE));
+        Batch += k;
+        Count -= k;
+        Head += k;
+    }
+    __atomic_store_n(&Shm->Head, Head, __ATOMIC_RELEASE);
+}
+
+/******************************************************************************
+function:   Send the frames in Hdr/Iov to every transport
+parameter:
+    Frames : frames in the batch
+    Batch  : the samples they carry, Count of them
+******************************************************************************/
+static void Daemon_Publish(UDOUBLE Frames, const ADS1263_SAMPLE *Batch, UDOUBLE Count)
+{
+    UDOUBLE i;
+    int r;
+
+    // one datagram per frame, lost ones are not retried
+    for(i = 0; Udp >= 0 && i < Frames; i += r) {
+        r = sendmmsg(Udp, Msg + i, Frames - i, MSG_DONTWAIT);
+        if(r <= 0)
+            break;
+    }
+    for(i = 0; i < DAEMON_MAXCLIENT; i++) {
+        if(Client[i].Fd >= 0)
+            Daemon_ClientSend(&Client[i], Iov, 2 * Frames, Frames);
+    }
+    if(Shm != NULL)
+        Daemon_ShmWrite(Batch, Count);
+}
+
+/******************************************************************************
+function:   Frame and send what the acquisition ring holds
+parameter:
+    Force : 1 send a short frame for the remainder, 0 full frames only
+Info:
+    Frames point straight into the ring, which is released once every
+    transport has been served.
+******************************************************************************/
+static void Daemon_Flush(UBYTE Force)
+{
+    ADS1263_SAMPLE *Batch;
+    UDOUBLE n, Used, Frames, k;
+    UBYTE Partial;
+
+    for(;;) {
+        n = ADS1263_Stream_Peek(&Stream, &Batch);
+        if(n == 0)
+            return;
+        // a run cut short by the ring wrap is sent as it is
+        Partial = Force || ADS1263_Stream_Available(&Stream) > n;
+        for(Frames = 0, Used = 0; Frames < DAEMON_BATCH && Used < n; Frames++, Used += k) {
+            k = n - Used < Records ? n - Used : Records;
+            if(k < Records && !Partial)
+                break;
+            Daemon_Header(&Hdr[Frames], ADS1263_NET_DATA, k, 0);
+            Iov[2 * Frames + 1].iov_base = Batch + Used;
+            Iov[2 * Frames + 1].iov_len = k * sizeof(ADS1263_SAMPLE);
+            Seq++;
+        }
+        if(Frames == 0)
+            return;
+        Daemon_Publish(Frames, Batch, Used);
+        ADS1263_Stream_Release(&Stream, Used);
+    }
+}
+
+/******************************************************************************
+function:   Start the stream with new settings
+parameter:
+    NewRate : ADS1263_DRATE
+    NewMode : 0 single-ended, 1 differential
+    NewList : channels, checked against NewMode
+Info:   The stream must be stopped. Return 0 success, 1 failed
+******************************************************************************/
+static UBYTE Daemon_Configure(UBYTE NewRate, UBYTE NewMode, const UBYTE *NewList, UBYTE NewNumber)
+{
+    if(NewRate > ADS1263_38400SPS || NewMode > 1)
+        return 1;
+    ADS1263_SetMode(&Dev, NewMode);
+    if(ADS1263_Stream_CheckList(&Dev, NewList, NewNumber) != 0)
+        return 1;
+    ADS1263_WriteReg(&Dev, REG_MODE2, (ADS1263_GetReg(&Dev, REG_MODE2) & 0xf0) | NewRate);
+    if(ADS1263_Stream_Start(&Stream, &Dev, NewList, NewNumber) != 0)
+        return 1;
+    Rate = NewRate;
+    Mode = NewMode;
+    memmove(List, NewList, NewNumber);
+    Number = NewNumber;
+    return 0;
+}
+
+/******************************************************************************
+function:   Switch the stream to new settings
+Info:
+    Everything taken with the old settings is sent first, so the frames
+    from Seq on are the new ones. Falls back to the old settings if the new
+    ones do not start. Return 0 success, 1 failed
+******************************************************************************/
+static UBYTE Daemon_Apply(UBYTE NewRate, UBYTE NewMode, const UBYTE *NewList, UBYTE NewNumber)
+{
+    ADS1263_Stream_Stop(&Stream);
+    Daemon_Flush(1);
+    Dropped += ADS1263_Stream_Dropped(&Stream);
+    if(Daemon_Configure(NewRate, NewMode, NewList, NewNumber) == 0) {
+        printf("rate %d, mode %d, %d channels \r\n", Rate, Mode, Number);
+        return 0;
+    }
+    Log_Warn("Daemon_Apply: settings rejected, keeping the old ones \r\n");
+    if(Daemon_Configure(Rate, Mode, List, Number) != 0)
+        Log_Error("Daemon_Apply: stream did not restart \r\n");
+    return 1;
+}
+
+/******************************************************************************
+function:   Run one command line from a client
+Info:
+    RATE <0-15>                  ADS1263_DRATE
+    SCAN <0|1> <ch>[,<ch>...]    mode and channel list, up to 11
+    Answered with a REPLY frame to that client only.
+******************************************************************************/
+static void Daemon_Command(DAEMON_CLIENT *C, char *Line)
+{
+    ADS1263_NET_HEADER Reply;
+    struct iovec v;
+    UBYTE NewList[ADS1263_STREAM_MAXCH], NewNumber, Result = 1;
+    char *Tok, *Save;
+    long n;
+
+    Tok = strtok_r(Line, " \t", &Save);
+    if(Tok == NULL)
+        return;
+    if(strcasecmp(Tok, "RATE") == 0) {
+        if(Daemon_Number(strtok_r(NULL, " \t", &Save), ADS1263_38400SPS, &n) == 0
+            && strtok_r(NULL, " \t", &Save) == NULL)
+            Result = Daemon_Apply(n, Mode, List, Number);
+    }
+    else if(strcasecmp(Tok, "SCAN") == 0) {
+        if(Daemon_Number(strtok_r(NULL, " \t", &Save), 1, &n) == 0
+            && (NewNumber = Daemon_List(NULL, &Save, n, NewList)) != 0)
+            Result = Daemon_Apply(Rate, n, NewList, NewNumber);
+    }
+    Daemon_Header(&Reply, ADS1263_NET_REPLY, 0, Result);
+    v.iov_base = &Reply;
+    v.iov_len = sizeof(Reply);
+    Daemon_ClientSend(C, &v, 1, 0);
+}
+
+/******************************************************************************
+function:   Read command bytes from a client
+******************************************************************************/
+static void Daemon_ClientRead(DAEMON_CLIENT *C)
+{
+    char Buf[DAEMON_READ];
+    ssize_t r, i;
+
+    // Pend only has room for the replies to one read
+    if(C->Reply)
+        return;
+    r = recv(C->Fd, Buf, sizeof(Buf), MSG_DONTWAIT);
+    if(r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        Daemon_ClientClose(C);
+        return;
+    }
+    for(i = 0; i < r && C->Fd >= 0; i++) {
+        if(Buf[i] == '\n' || Buf[i] == '\r') {
+            C->Line[C->LineLen] = '\0';
+            if(C->LineLen > 0)
+                Daemon_Command(C, C->Line);
+            C->LineLen = 0;
+        }
+        else if(C->LineLen < DAEMON_LINE - 1) {
+            C->Line[C->LineLen++] = Buf[i];
+        }
+    }
+}
+
+static void Daemon_Accept(void)
+{
+    int fd, one = 1, i;
+
+    fd = accept(Listen, NULL, NULL);
+    if(fd < 0)
+        return;
+    for(i = 0; i < DAEMON_MAXCLIENT && Client[i].Fd >= 0; i++)
+        ;
+    if(i == DAEMON_MAXCLIENT || (Client[i].Pend = malloc(DAEMON_PEND)) == NULL) {
+        Log_Warn("Daemon_Accept: no free client slot \r\n");
+        close(fd);
+        return;
+    }
+    // frames are batched already, do not hold them back any further
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    Client[i].Fd = fd;
+    Client[i].LineLen = 0;
+    Client[i].PendOff = Client[i].PendLen = 0;
+    Client[i].Reply = 0;
+    Client[i].Skipped = 0;
+    printf("client %d connected \r\n", fd);
+}
+
+static int Daemon_Listen(const char *Addr, int Port)
+{
+    struct sockaddr_in sa = {0};
+    int fd, one = 1;
+
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(Port);
+    if(inet_pton(AF_INET, Addr, &sa.sin_addr) != 1) {
+        Log_Error("Daemon_Listen: bad address %s \r\n", Addr);
+        return -1;
+    }
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if(fd < 0)
+        return -1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if(bind(fd, (struct sockaddr *)&sa, sizeof(sa)) != 0 || listen(fd, 4) != 0) {
+        Log_Error("Daemon_Listen: %s:%d: %s \r\n", Addr, Port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/******************************************************************************
+function:   Open the UDP socket, host:port may be a multicast group
+******************************************************************************/
+static int Daemon_Udp(char *Dest)
+{
+    struct addrinfo Hint = {0}, *Res;
+    char *Port = strrchr(Dest, ':');
+    int fd;
+
+    if(Port == NULL)
+        return -1;
+    *Port++ = '\0';
+    Hint.ai_family = AF_INET;
+    Hint.ai_socktype = SOCK_DGRAM;
+    if(getaddrinfo(Dest, Port, &Hint, &Res) != 0) {
+        Log_Error("Daemon_Udp: cannot resolve %s \r\n", Dest);
+        return -1;
+    }
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if(fd >= 0 && connect(fd, Res->ai_addr, Res->ai_addrlen) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(Res);
+    return fd;
+}
+
+static UBYTE Daemon_ShmOpen(const char *Name)
+{
+    int fd;
+
+    snprintf(ShmName, sizeof(ShmName), "/%s", Name[0] == '/' ? Name + 1 : Name);
+    ShmBytes = sizeof(ADS1263_NET_SHM) + (size_t)DAEMON_SHMSIZE * sizeof(ADS1263_NET_RECORD);
+    fd = shm_open(ShmName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0 || ftruncate(fd, ShmBytes) != 0) {
+        Log_Error("Daemon_ShmOpen: %s: %s \r\n", ShmName, strerror(errno));
+        if(fd >= 0)
+            close(fd);
+        return 1;
+    }
+    Shm = mmap(NULL, ShmBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(Shm == MAP_FAILED) {
+        Shm = NULL;
+        shm_unlink(ShmName);
+        return 1;
+    }
+    // ftruncate zero-filled Head and Claim
+    Shm->Version = ADS1263_NET_VERSION;
+    Shm->Size = DAEMON_SHMSIZE;
+    Shm->Board = Board;
+    __atomic_store_n(&Shm->Magic, ADS1263_NET_SHM_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/******************************************************************************
+function:   Close every transport, the shared-memory ring is removed
+******************************************************************************/
+static void Daemon_Close(void)
+{
+    int i;
+    for(i = 0; i < DAEMON_MAXCLIENT; i++)
+        Daemon_ClientClose(&Client[i]);
+    if(Listen >= 0)
+        close(Listen);
+    if(Udp >= 0)
+        close(Udp);
+    if(Shm != NULL) {
+        munmap(Shm, ShmBytes);
+        shm_unlink(ShmName);
+    }
+    Listen = Udp = -1;
+    Shm = NULL;
+}
+
+static void Daemon_Usage(const char *Name)
+{
+    printf("Usage: %s [-r rate] [-m mode] [-c channels] [-a n] [-t port] [-l addr] [-u host:port] [-s name] [-b board] [-n records] [-i ms]\r\n", Name);
+    printf("  -r  ADS1263_DRATE index, 0 (2.5SPS) - 15 (38400SPS), default 9 (1200SPS)\r\n");
+    printf("  -m  0 single-ended (default), 1 differential\r\n");
+    printf("  -c  channel list, e.g. 0,1,2, default 0\r\n");
+    printf("  -a  send the mean of every n samples per channel (ADS1263_DECIM_MEAN)\r\n");
+    printf("  -t  TCP port for clients and commands, default %d, 0 none\r\n", ADS1263_NET_PORT);
+    printf("  -l  address to listen on, default 0.0.0.0\r\n");
+    printf("  -u  also send every frame as a datagram to host:port, unicast or multicast\r\n");
+    printf("  -s  also fill the shared-memory ring /dev/shm/name\r\n");
+    printf("  -b  board id carried in every frame, default 0\r\n");
+    printf("  -n  records per frame, 1-%d, default 64\r\n", (int)ADS1263_NET_MAXREC);
+    printf("  -i  longest time a sample waits for its frame in ms, default 10\r\n");
+}
+
+int main(int argc, char **argv)
+{
+    struct pollfd Fds[DAEMON_MAXCLIENT + 1];
+    int Who[DAEMON_MAXCLIENT + 1];
+    const char *Addr = "0.0.0.0";
+    char *UdpDest = NULL, *ShmArg = NULL, *Save;
+    long Port = ADS1263_NET_PORT, Average = 0, Interval = 10, v;
+    uint64_t Now, Last;
+    int opt, n, i, Bad = 0;
+
+    while((opt = getopt(argc, argv, "r:m:c:a:t:l:u:s:b:n:i:h")) != -1) {
+        switch(opt) {
+        case 'r': Bad |= Daemon_Number(optarg, ADS1263_38400SPS, &v); Rate = v; break;
+        case 'm': Bad |= Daemon_Number(optarg, 1, &v); Mode = v; break;
+        case 'c': Number = Daemon_List(optarg, &Save, 0, List); Bad |= Number == 0; break;
+        case 'a': Bad |= Daemon_Number(optarg, 65536, &Average); break;
+        case 't': Bad |= Daemon_Number(optarg, 65535, &Port); break;
+        case 'l': Addr = optarg; break;
+        case 'u': UdpDest = optarg; break;
+        case 's': ShmArg = optarg; break;
+        case 'b': Bad |= Daemon_Number(optarg, 0x7fffffff, &v); Board = v; break;
+        case 'n': Bad |= Daemon_Number(optarg, ADS1263_NET_MAXREC, &v) || v == 0; Records = v; break;
+        case 'i': Bad |= Daemon_Number(optarg, 10000, &Interval) || Interval == 0; break;
+        default:
+            Daemon_Usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if(Bad) {
+        Daemon_Usage(argv[0]);
+        return 1;
+    }
+    for(i = 0; i < DAEMON_MAXCLIENT; i++)
+        Client[i].Fd = -1;
+    for(i = 0; i < DAEMON_BATCH; i++) {
+        Iov[2 * i].iov_base = &Hdr[i];
+        Iov[2 * i].iov_len = sizeof(ADS1263_NET_HEADER);
+        Msg[i].msg_hdr.msg_iov = &Iov[2 * i];
+        Msg[i].msg_hdr.msg_iovlen = 2;
+    }
+
+    signal(SIGINT, Handler);
+    signal(SIGTERM, Handler);
+    signal(SIGPIPE, SIG_IGN);
+
+    if((Port > 0 && (Listen = Daemon_Listen(Addr, Port)) < 0)
+        || (UdpDest != NULL && (Udp = Daemon_Udp(UdpDest)) < 0)
+        || (ShmArg != NULL && Daemon_ShmOpen(ShmArg) != 0)) {
+        printf("cannot open the transports. Exiting.\r\n");
+        Daemon_Close();
+        return 1;
+    }
+    if(DEV_Module_Init() != 0) {
+        printf("DEV_Module_Init failed. Exiting.\r\n");
+        Daemon_Close();
+        return 1;
+    }
+    ADS1263_Device_Init(&Dev, &DEV_Port0);
+    ADS1263_SetMode(&Dev, Mode);
+    if(ADS1263_init_ADC1(&Dev, Rate) == 1 || ADS1263_Stream_Init(&Stream, DAEMON_RING) != 0) {
+        Daemon_Close();
+        DEV_Module_Exit();
+        return 1;
+    }
+    if(Average > 1) {
+        if(ADS1263_Decim_Init(&Decim, ADS1263_DECIM_MEAN, Average, 0) != 0) {
+            Daemon_Close();
+            ADS1263_Stream_Free(&Stream);
+            DEV_Module_Exit();
+            return 1;
+        }
+        ADS1263_Stream_SetDecim(&Stream, &Decim);
+    }
+    if(Daemon_Configure(Rate, Mode, List, Number) != 0) {
+        printf("channel list does not fit the mode. Exiting.\r\n");
+        Daemon_Close();
+        ADS1263_Stream_Free(&Stream);
+        DEV_Module_Exit();
+        return 1;
+    }
+    printf("ads1263d: board %u, rate %d, mode %d, %d channels, TCP %ld%s%s \r\n", Board, Rate, Mode, Number,
+        Port, Udp >= 0 ? ", UDP" : "", Shm != NULL ? ", shm" : "");
+
+    Last = Daemon_Now();
+    while(!Quit) {
+        n = 0;
+        if(Listen >= 0) {
+            Fds[n].fd = Listen;
+            Fds[n].events = POLLIN;
+            Who[n++] = -1;
+        }
+        for(i = 0; i < DAEMON_MAXCLIENT; i++) {
+            if(Client[i].Fd < 0)
+                continue;
+            Fds[n].fd = Client[i].Fd;
+            Fds[n].events = (Client[i].Reply ? 0 : POLLIN) | (Client[i].PendLen > 0 ? POLLOUT : 0);
+            Who[n++] = i;
+        }
+        if(poll(Fds, n, Interval) > 0) {
+            for(i = 0; i < n; i++) {
+                if(Fds[i].revents == 0)
+                    continue;
+                if(Who[i] < 0) {
+                    Daemon_Accept();
+                    continue;
+                }
+                if((Fds[i].revents & POLLOUT) && Daemon_ClientDrain(&Client[Who[i]]) != 0)
+                    continue;
+                if(Fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+                    Daemon_ClientRead(&Client[Who[i]]);
+            }
+        }
+        Now = Daemon_Now();
+        if(Now - Last >= (uint64_t)Interval * 1000000) {
+            Daemon_Flush(1);
+            Last = Now;
+        }
+        else {
+            Daemon_Flush(0);
+        }
+    }
+
+    ADS1263_Stream_Stop(&Stream);
+    Daemon_Flush(1);
+    printf("\r\n END, %u frames, %u dropped \r\n", Seq, Dropped + ADS1263_Stream_Dropped(&Stream));
+    Daemon_Close();
+    ADS1263_Stream_Free(&Stream);
+    DEV_Module_Exit();
+    return 0;
+}
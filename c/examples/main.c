@@ -2,15 +2,23 @@
 #include <signal.h>     //signal()
 #include <time.h>
 #include "ADS1263.h"
+#include "ADS1263_Stream.h"
+#include "ADS1263_Capture.h"
+#include "ADS1263_Convert.h"
+#include "ADS1263_RTD.h"
 #include "stdio.h"
 #include <string.h>
 
 // ADC1 test part
 #define TEST_ADC1       1
-// ADC1 rate test par
-#define TEST_ADC1_RATE  0
+// ADC1 streaming test part
+#define TEST_ADC1_STREAM 0
+// ADC1 streaming to capture files test part
+#define TEST_ADC1_CAPTURE 0
 // ADC2 test part
 #define TEST_ADC2       0
+// ADC1 + ADC2 dual acquisition test part
+#define TEST_DUAL       0
 // RTD test part    
 #define TEST_RTD        0
 
@@ -29,7 +37,9 @@ int main(void)
 {
     UDOUBLE ADC[10];
     UWORD i;
-    double RES, TEMP;
+    double Volt[10];
+    ADS1263_VCONV Conv;
+    ADS1263_DEVICE Dev;
     
     // Exception handling:ctrl + c
     signal(SIGINT, Handler);
@@ -39,21 +49,24 @@ int main(void)
         printf("DEV_Module_Init failed. Exiting.\r\n");
         return 1;
     }
+    // DEV_Port0 is the HAT on the default pins, see DEV_Port_Init for more boards
+    ADS1263_Device_Init(&Dev, &DEV_Port0);
+    // ADS1263_SetFastStart(&Dev, 1);    // ~9 ms reset instead of 0.9 s, board already powered
 
     // 0 is singleChannel, 1 is diffChannel
-    ADS1263_SetMode(0);
+    ADS1263_SetMode(&Dev, 0);
     
     // The faster the rate, the worse the stability
     // and the need to choose a suitable digital filter(REG_MODE1)
-    if(ADS1263_init_ADC1(ADS1263_400SPS) == 1) {
+    if(ADS1263_init_ADC1(&Dev, ADS1263_400SPS) == 1) {
         printf("\r\n END \r\n");
         DEV_Module_Exit();
         exit(0);
     }
     
     /* Test DAC */
-    // ADS1263_DAC(ADS1263_DAC_VLOT_3, Positive_A6, Open);      
-    // ADS1263_DAC(ADS1263_DAC_VLOT_2, Negative_A7, Open);
+    // ADS1263_DAC(&Dev, ADS1263_DAC_VLOT_3, Positive_A6, Open);      
+    // ADS1263_DAC(&Dev, ADS1263_DAC_VLOT_2, Negative_A7, Open);
     
     if(TEST_ADC1) {
         printf("TEST_ADC1\r\n");
@@ -62,13 +75,12 @@ int main(void)
         UBYTE ChannelList[ChannelNumber] = {0, 1, 2, 3, 4};    // The channel must be less than 10
             
         UDOUBLE Value[ChannelNumber] = {0};
+        ADS1263_VConv_ADC1(&Conv, REF, ADS1263_GAIN_1, 0);
         while(1) {
-            ADS1263_GetAll(ChannelList, Value, ChannelNumber);  // Get ADC1 value
+            ADS1263_GetAll(&Dev, ChannelList, Value, ChannelNumber);  // Get ADC1 value
+            ADS1263_ToVolt_Double(&Conv, Value, Volt, ChannelNumber);
             for(i=0; i<ChannelNumber; i++) {
-                if((Value[i]>>31) == 1)
-                    printf("IN%d is -%lf \r\n", ChannelList[i], REF*2 - Value[i]/2147483648.0 * REF);      //7fffffff + 1
-                else
-                    printf("IN%d is %lf \r\n", ChannelList[i], Value[i]/2147483647.0 * REF);       //7fffffff
+                printf("IN%d is %lf \r\n", ChannelList[i], Volt[i]);
             }
             for(i=0; i<ChannelNumber; i++) {
                 printf("\33[1A");   // Move the cursor up
@@ -77,57 +89,126 @@ int main(void)
     }
     else if(TEST_ADC2) {
         printf("TEST_ADC2\r\n");
-        if(ADS1263_init_ADC2(ADS1263_ADC2_100SPS) == 1) {
+        if(ADS1263_init_ADC2(&Dev, ADS1263_ADC2_100SPS) == 1) {
             printf("\r\n END \r\n");
             DEV_Module_Exit();
             exit(0);
         }
+        ADS1263_VConv_ADC2(&Conv, REF, ADS1263_ADC2_GAIN_1, 0);
         while(1) {
-            ADS1263_GetAll_ADC2(ADC);   // Get ADC2 value
+            ADS1263_GetAll_ADC2(&Dev, ADC);   // Get ADC2 value
+            ADS1263_ToVolt_Double(&Conv, ADC, Volt, 10);
             for(i=0; i<10; i++) {
-                if((ADC[i]>>23) == 1)
-                    printf("IN%d is -%lf \r\n", i, REF*2 - ADC[i]/8388608.0 * REF);     //7fffff + 1
-                else
-                    printf("IN%d is %lf \r\n", i, ADC[i]/8388607.0 * REF);      //7fffff
+                printf("IN%d is %lf \r\n", i, Volt[i]);
             }
             printf("\33[10A");//Move the cursor up
         }
     }
-    else if(TEST_ADC1_RATE) {
-        printf("TEST_ADC1_RATE\r\n");
-        struct timespec start={0, 0}, finish={0, 0}; 
-        clock_gettime(CLOCK_REALTIME, &start);
-        double time;
-        UBYTE isSingleChannel = 0;
-        if(isSingleChannel) {
-            for(i=0; i<10000; i++) {
-                ADS1263_GetChannalValue(0);
+    else if(TEST_DUAL) {
+        printf("TEST_DUAL\r\n");
+        // ADC1 fast on IN0, ADC2 slowly walks the housekeeping inputs
+        UBYTE HouseList[4] = {6, 7, 8, 9};
+        UDOUBLE House[4] = {0};
+        ADS1263_SAMPLE Fast, Slow;
+        if(ADS1263_init_Dual(&Dev, ADS1263_1200SPS, ADS1263_ADC2_100SPS) == 1
+            || ADS1263_SelectChannal(&Dev, 0) != 0 || ADS1263_SetDualList(&Dev, HouseList, 4) != 0) {
+            printf("\r\n END \r\n");
+            DEV_Module_Exit();
+            exit(0);
+        }
+        while(1) {
+            if(!(ADS1263_ReadDual(&Dev, &Fast, &Slow) & ADS1263_DUAL_ADC2))
+                continue;
+            for(i=0; i<4; i++) {
+                if(HouseList[i] == Slow.Channel)
+                    House[i] = Slow.Value;
             }
-            clock_gettime(CLOCK_REALTIME, &finish);
-            time =  (double)(finish.tv_sec-start.tv_sec)*1000.0 + (double)(finish.tv_nsec-start.tv_nsec)/1000000.0;
-            printf("%lf ms\r\n", time);
-            printf("single channel %lf kHz\r\n", 10000 / time);
-
+            printf("ADC1 IN0 is %lf \r\n", (int32_t)Fast.Value / 2147483648.0 * REF);
+            for(i=0; i<4; i++) {
+                // sign-extend the 24-bit ADC2 code
+                printf("ADC2 IN%d is %lf \r\n", HouseList[i], ((int32_t)(House[i] << 8) >> 8) / 8388608.0 * REF);
+            }
+            printf("\33[5A");  // Move the cursor up
         }
-        else {
-            for(i=0; i<10000; i++) {
-                ADS1263_GetChannalValue(0);
+    }
+    else if(TEST_ADC1_STREAM) {
+        printf("TEST_ADC1_STREAM\r\n");
+        #define StreamBatch 256
+        ADS1263_STREAM Stream;
+        ADS1263_SAMPLE Batch[StreamBatch];
+        UDOUBLE BatchBad[StreamBatch / 32];
+        UBYTE StreamList[1] = {0};
+        UDOUBLE n, Total = 0, Bad = 0;
+        ADS1263_SetCrcDefer(&Dev, 1);      // checked below, one batch at a time
+        if(ADS1263_Stream_Init(&Stream, 16384) != 0 || ADS1263_Stream_Start(&Stream, &Dev, StreamList, 1) != 0) {
+            DEV_Module_Exit();
+            exit(0);
+        }
+        while(1) {
+            n = ADS1263_Stream_Read(&Stream, Batch, StreamBatch);
+            if(n == 0) {
+                usleep(10000);
+                continue;
             }
-            clock_gettime(CLOCK_REALTIME, &finish);
-            time =  (double)(finish.tv_sec-start.tv_sec)*1000.0 + (double)(finish.tv_nsec-start.tv_nsec)/1000000.0;
-            printf("%lf ms\r\n", time);
-            printf("multi channel %lf kHz\r\n", 10000 / time);
+            Total += n;
+            Bad += ADS1263_CheckBlock(&Dev, Batch, n, BatchBad);
+            printf("IN%d is %lf, %u samples, %u dropped, %u bad \r\n", Batch[n-1].Channel,
+                (int32_t)Batch[n-1].Value / 2147483648.0 * REF, Total, ADS1263_Stream_Dropped(&Stream), Bad);
+            printf("\33[1A");   // Move the cursor up
+        }
+    }
+    else if(TEST_ADC1_CAPTURE) {
+        printf("TEST_ADC1_CAPTURE\r\n");
+        ADS1263_STREAM Stream;
+        ADS1263_CAPTURE Cap;
+        UBYTE StreamList[1] = {0};
+        if(ADS1263_init_ADC1(&Dev, ADS1263_38400SPS) == 1
+            || ADS1263_Capture_Open(&Cap, "capture", 64 << 20) != 0) {     // 4M samples per file
+            DEV_Module_Exit();
+            exit(0);
+        }
+        if(ADS1263_Stream_Init(&Stream, 65536) != 0 || ADS1263_Stream_Start(&Stream, &Dev, StreamList, 1) != 0) {
+            ADS1263_Capture_Close(&Cap);
+            DEV_Module_Exit();
+            exit(0);
+        }
+        while(1) {
+            usleep(100000);
+            ADS1263_Capture_Drain(&Cap, &Stream);
+            if(!ADS1263_Capture_IsOpen(&Cap)) {
+                // disk full or not writable, the error is logged above
+                printf("\r\ncapture failed after %llu samples \r\n", (unsigned long long)Cap.Written);
+                ADS1263_Stream_Stop(&Stream);
+                ADS1263_Stream_Free(&Stream);
+                DEV_Module_Exit();
+                exit(1);
+            }
+            printf("%llu samples in %u files, %u dropped \r\n", (unsigned long long)Cap.Written,
+                Cap.Segment + 1, ADS1263_Stream_Dropped(&Stream));
+            printf("\33[1A");   // Move the cursor up
         }
-
     }
     else if(TEST_RTD) {
         printf("TEST_RTD\r\n");
-        ADC[0] = ADS1263_RTD(ADS1263_DELAY_8d8ms, ADS1263_GAIN_1, ADS1263_20SPS);
-        RES = ADC[0]/2147483647.0 * 2.0 * 2000.0;   //2000.0 -- 2000R, 2.0 -- 2*i
-        printf("Res is %lf \r\n", RES);
-        TEMP = (RES/100.0 - 1.0) / 0.00385;     //0.00385 -- pt100
-        printf("Temp is %lf \r\n", TEMP);
-        printf("\33[2A");//Move the cursor up
+        // PT100 across AIN7/AIN6, IDAC1 AIN3 and IDAC2 AINCOM at 250uA, 2000R reference on AIN4/AIN5;
+        // both currents flow through the reference, 2 * i
+        ADS1263_RTD_CHANNEL Rtd[1] = {{7, 6, (0x0a<<4) | 0x03, (0x03<<4) | 0x03, (0x03<<3) | 0x03, 2000.0, 2.0, 100.0}};
+        ADS1263_RTD_SCAN RtdScan;
+        ADS1263_ADC1_CONFIG RtdConfig;
+        float Res[1], Temp[1];
+        ADS1263_ADC1_DefaultConfig(&RtdConfig, ADS1263_20SPS);
+        RtdConfig.Delay = ADS1263_DELAY_8d8ms;      // IDAC settling
+        RtdConfig.Bypass = 0;                       // PGA on at gain 1, as ADS1263_RTD()
+        if(ADS1263_ConfigureADC1(&Dev, &RtdConfig) != 0 || ADS1263_RTDScan_Build(&Dev, &RtdScan, Rtd, 1) != 0) {
+            DEV_Module_Exit();
+            exit(0);
+        }
+        while(1) {
+            ADS1263_RTDScan_Run(&Dev, &RtdScan, Res, Temp);
+            printf("Res is %f \r\n", Res[0]);
+            printf("Temp is %f \r\n", Temp[0]);
+            printf("\33[2A");//Move the cursor up
+        }
     }
 
     return 0;
@@ -28,23 +28,52 @@
 #
 ******************************************************************************/
 #include "DEV_Config.h"
+#include "dev_gpio_event.h"
 #include <fcntl.h>
+#include <time.h>
 /* for fallback to spidev-based hardware SPI if bcm2835 fails */
 #ifdef RPI
 #include "dev_hardware_SPI.h"
 #include "RPI_sysfs_gpio.h"
+#include "RPI_gpiomem.h"
+#endif
+#if defined(JETSON) && defined(USE_HARDWARE_LIB)
+#include "dev_hardware_SPI.h"
 #endif
 
 /**
  * GPIO
 **/
-int DEV_RST_PIN;
-int DEV_CS_PIN;
-int DEV_DRDY_PIN;
+/* one lock per SPI controller, /dev/spidevB.C shares it with every other B;
+ * backends that drive a single bus use bus 0 */
+#define DEV_SPI_MAXBUS	8
+static pthread_mutex_t DEV_SPI_Bus[DEV_SPI_MAXBUS] = {
+	PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+};
+
+DEV_PORT DEV_Port0 = {0, 0, 0, -1, {-1, 0}, &DEV_SPI_Bus[0]};
+
+/* the HAT's CS (BCM 22), or the spidev chip select with make HW_CS=1 */
+#ifdef DEV_SPI_HW_CS
+#define DEV_PORT0_CS    DEV_CS_HARDWARE
+#else
+#define DEV_PORT0_CS    22
+#endif
 
 /* runtime selector: use bcm2835 lib when available, otherwise use sysfs/dev interface */
 static int use_bcm2835 = 0;
 
+#if defined(RPI) && (defined(USE_BCM2835_LIB) || defined(USE_DEV_LIB))
+/* Pi 5: GPIO through the mmapped RP1 registers instead of sysfs */
+static int use_rp1 = 0;
+#endif
+
+#if defined(JETSON) && defined(USE_HARDWARE_LIB)
+/* Jetson without an enabled spidev node: bit-banged SPI on the same pins */
+static int use_softspi = 0;
+#endif
+
 /* GPIO offset for sysfs: 0 for Pi 4 and earlier, 571 for Pi 5 */
 static int gpio_sysfs_offset = 0;
 
@@ -65,59 +94,357 @@ static int detect_pi5_gpio_offset(void)
 	}
 	return 0;
 }
+/* builds that reach the pins through sysfs, on their own or as fallback */
+#if (defined(RPI) && (defined(USE_BCM2835_LIB) || defined(USE_DEV_LIB))) || defined(JETSON)
+#define DEV_HAS_SYSFS   1
+#endif
+
+/* builds with a spidev backend */
+#if (defined(RPI) && (defined(USE_BCM2835_LIB) || defined(USE_DEV_LIB))) || (defined(JETSON) && defined(USE_HARDWARE_LIB))
+#define DEV_HAS_SPIDEV  1
+#endif
+
 /**
- * GPIO read and write
+ * HAL backends: one ops table per way of reaching the pins and the bus.
+ * DEV_Module_Init copies the fastest one available into DEV_Hal_Ops, so
+ * the DEV_xxx calls below are a single indirect call with no branching.
 **/
-void DEV_Digital_Write(UWORD Pin, UBYTE Value)
+static UBYTE DEV_Wait_DRDY_Poll(DEV_PORT *Port, UDOUBLE Timeout_us);
+static UBYTE DEV_Wait_DRDY_Event(DEV_PORT *Port, UDOUBLE Timeout_us);
+static DEV_HAL DEV_Hal_Ops;
+
+static void DEV_None_Write(UWORD Pin, UBYTE Value)
+{
+	Debug("not support");
+}
+
+static UBYTE DEV_None_Read(UWORD Pin)
+{
+	Debug("not support");
+	return 0;
+}
+
+static void DEV_None_Transfer(DEV_PORT *Port, UBYTE *Buf, UDOUBLE Len)
+{
+	Debug("not support");
+}
+
+/* wake-up lateness of clock_nanosleep, spun through at the end of a delay; see DEV_Delay_Calibrate */
+#define DEV_SLEEP_SLACK_MIN_US	10
+#define DEV_SLEEP_SLACK_MAX_US	500
+static UDOUBLE DEV_Sleep_Slack_us = 60;
+
+static void DEV_Time_Add_us(struct timespec *ts, UDOUBLE xus)
+{
+	ts->tv_sec += xus / 1000000;
+	ts->tv_nsec += (long)(xus % 1000000) * 1000;
+	if (ts->tv_nsec >= 1000000000L) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000L;
+	}
+}
+
+static int DEV_Time_Before(const struct timespec *a, const struct timespec *b)
+{
+	return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+/* sleep to an absolute deadline less the slack, then spin to it */
+static void DEV_Sleep_us(UDOUBLE xus)
+{
+	struct timespec end, wake, now;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	wake = end;
+	DEV_Time_Add_us(&end, xus);
+	if (xus > DEV_Sleep_Slack_us) {
+		DEV_Time_Add_us(&wake, xus - DEV_Sleep_Slack_us);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR);
+	}
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	} while (DEV_Time_Before(&now, &end));
+}
+
+/******************************************************************************
+function:	Measure how late clock_nanosleep wakes this thread
+parameter:
+Info:
+	The worst of a few 200 us sleeps becomes the spin at the end of each
+	DEV_Sleep_us, so short delays are neither early nor a timer tick late.
+******************************************************************************/
+static void DEV_Delay_Calibrate(void)
 {
+	struct timespec wake, now;
+	UDOUBLE i, late, worst = 0;
+	for (i = 0; i < 8; i++) {
+		clock_gettime(CLOCK_MONOTONIC, &wake);
+		DEV_Time_Add_us(&wake, 200);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR);
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		late = (now.tv_sec - wake.tv_sec) * 1000000 + (now.tv_nsec - wake.tv_nsec) / 1000;
+		if (late > worst)
+			worst = late;
+	}
+	if (worst < DEV_SLEEP_SLACK_MIN_US)
+		worst = DEV_SLEEP_SLACK_MIN_US;
+	if (worst > DEV_SLEEP_SLACK_MAX_US)
+		worst = DEV_SLEEP_SLACK_MAX_US;
+	DEV_Sleep_Slack_us = worst;
+}
+
+/* backends without a native chain: the frames go out one by one, CS stays with the caller */
+static void DEV_Loop_Transfer_Chain(DEV_PORT *Port, DEV_SPI_XFER *Xfer, UBYTE Number)
+{
+	UBYTE i;
+	for(i = 0; i < Number; i++) {
+		DEV_Hal_Ops.spi_transfer_buf(Port, Xfer[i].Buf, Xfer[i].Len);
+	}
+}
+
+/* before DEV_Module_Init, and for backends with no driver */
+static const DEV_HAL DEV_HAL_None = {
+	"none", DEV_None_Write, DEV_None_Read, DEV_None_Transfer, DEV_Wait_DRDY_Poll, DEV_Sleep_us, DEV_Loop_Transfer_Chain,
+};
+
+#ifdef DEV_HAS_SPIDEV
+static void DEV_SPIDEV_Transfer(DEV_PORT *Port, UBYTE *Buf, UDOUBLE Len)
+{
+	DEV_HARDWARE_SPI_TransferFd(Port->SPI_fd, Buf, Len);
+}
+
+/* the whole chain is one SPI_IOC_MESSAGE(N) under one CS, GPIO or hardware, so no cs_change */
+static void DEV_SPIDEV_Transfer_Chain(DEV_PORT *Port, DEV_SPI_XFER *Xfer, UBYTE Number)
+{
+	HARDWARE_SPI_CHAIN Chain;
+	UBYTE i;
+
+	DEV_HARDWARE_SPI_ChainInit(&Chain);
+	for(i = 0; i < Number; i++) {
+		DEV_HARDWARE_SPI_ChainAdd(&Chain, Xfer[i].Buf, Xfer[i].Len, 0);
+	}
+	DEV_HARDWARE_SPI_ChainRun(Port->SPI_fd, &Chain);
+}
+#endif
+
 #ifdef RPI
 #ifdef USE_BCM2835_LIB
-	if (use_bcm2835) {
-		bcm2835_gpio_write(Pin, Value);
-	} else {
-		SYSFS_GPIO_Write(Pin, Value);
-	}
+static void DEV_BCM2835_Write(UWORD Pin, UBYTE Value)
+{
+	bcm2835_gpio_write(Pin, Value);
+}
+
+static UBYTE DEV_BCM2835_Read(UWORD Pin)
+{
+	return bcm2835_gpio_lev(Pin);
+}
+
+static void DEV_BCM2835_Transfer(DEV_PORT *Port, UBYTE *Buf, UDOUBLE Len)
+{
+	bcm2835_spi_transfernb((char *)Buf, (char *)Buf, Len);
+}
+
+static void DEV_BCM2835_Delay_us(UDOUBLE xus)
+{
+	bcm2835_delayMicroseconds(xus);
+}
+
+/* bcm2835_delayMicroseconds spins through anything from about 1 s up */
+static void DEV_BCM2835_Delay_ms(UDOUBLE xms)
+{
+	bcm2835_delay(xms);
+}
+
+static const DEV_HAL DEV_HAL_BCM2835 = {
+	"bcm2835", DEV_BCM2835_Write, DEV_BCM2835_Read, DEV_BCM2835_Transfer, DEV_Wait_DRDY_Poll, DEV_BCM2835_Delay_us, DEV_Loop_Transfer_Chain,
+	DEV_BCM2835_Delay_ms,
+};
 #elif USE_WIRINGPI_LIB
+static void DEV_WIRINGPI_Write(UWORD Pin, UBYTE Value)
+{
 	digitalWrite(Pin, Value);
-#elif USE_DEV_LIB
-	SYSFS_GPIO_Write(Pin, Value);
-#endif
+}
+
+static UBYTE DEV_WIRINGPI_Read(UWORD Pin)
+{
+	return digitalRead(Pin);
+}
+
+static void DEV_WIRINGPI_Transfer(DEV_PORT *Port, UBYTE *Buf, UDOUBLE Len)
+{
+	wiringPiSPIDataRW(0, Buf, Len);
+}
+
+static void DEV_WIRINGPI_Delay_us(UDOUBLE xus)
+{
+	delayMicroseconds(xus);
+}
+
+static void DEV_WIRINGPI_Delay_ms(UDOUBLE xms)
+{
+	delay(xms);
+}
+
+static const DEV_HAL DEV_HAL_WIRINGPI = {
+	"wiringPi", DEV_WIRINGPI_Write, DEV_WIRINGPI_Read, DEV_WIRINGPI_Transfer, DEV_Wait_DRDY_Poll, DEV_WIRINGPI_Delay_us, DEV_Loop_Transfer_Chain,
+	DEV_WIRINGPI_Delay_ms,
+};
 #endif
 
-#ifdef JETSON
-#ifdef USE_DEV_LIB
-	SYSFS_GPIO_Write(Pin, Value);
-#elif USE_HARDWARE_LIB
-	Debug("not support");
+#if defined(USE_BCM2835_LIB) || defined(USE_DEV_LIB)
+static void DEV_RP1_Write(UWORD Pin, UBYTE Value)
+{
+	RP1_GPIO_Write(Pin, Value);
+}
+
+static UBYTE DEV_RP1_Read(UWORD Pin)
+{
+	return RP1_GPIO_Read(Pin);
+}
+
+static const DEV_HAL DEV_HAL_RP1 = {
+	"spidev/RP1", DEV_RP1_Write, DEV_RP1_Read, DEV_SPIDEV_Transfer, DEV_Wait_DRDY_Poll, DEV_Sleep_us, DEV_SPIDEV_Transfer_Chain,
+};
 #endif
 #endif
+
+#ifdef DEV_HAS_SYSFS
+static void DEV_SYSFS_Write(UWORD Pin, UBYTE Value)
+{
+	SYSFS_GPIO_Write(Pin, Value);
 }
 
-UBYTE DEV_Digital_Read(UWORD Pin)
+static UBYTE DEV_SYSFS_Read(UWORD Pin)
 {
-	UBYTE Read_value = 0;
-#ifdef RPI
-#ifdef USE_BCM2835_LIB
-	if (use_bcm2835) {
-		Read_value = bcm2835_gpio_lev(Pin);
-	} else {
-		Read_value = SYSFS_GPIO_Read(Pin);
-	}
-#elif USE_WIRINGPI_LIB
-	Read_value = digitalRead(Pin);
-#elif USE_DEV_LIB
-	Read_value = SYSFS_GPIO_Read(Pin);
+	return SYSFS_GPIO_Read(Pin);
+}
 #endif
+
+#ifdef RPI
+#if defined(USE_BCM2835_LIB) || defined(USE_DEV_LIB)
+static const DEV_HAL DEV_HAL_SYSFS = {
+	"spidev/sysfs", DEV_SYSFS_Write, DEV_SYSFS_Read, DEV_SPIDEV_Transfer, DEV_Wait_DRDY_Poll, DEV_Sleep_us, DEV_SPIDEV_Transfer_Chain,
+};
 #endif
+#elif JETSON
+static void DEV_SOFTSPI_Transfer(DEV_PORT *Port, UBYTE *Buf, UDOUBLE Len)
+{
+	UDOUBLE i;
+	for(i=0; i < Len; i++) {
+		Buf[i] = SYSFS_software_spi_transfer(Buf[i]);
+	}
+}
 
-#ifdef JETSON
-#ifdef USE_DEV_LIB
-	Read_value = SYSFS_GPIO_Read(Pin);
-#elif USE_HARDWARE_LIB
-	Debug("not support");
+static const DEV_HAL DEV_HAL_SYSFS = {
+	"sysfs software SPI", DEV_SYSFS_Write, DEV_SYSFS_Read, DEV_SOFTSPI_Transfer, DEV_Wait_DRDY_Poll, DEV_Sleep_us, DEV_Loop_Transfer_Chain,
+};
+
+#ifdef USE_HARDWARE_LIB
+/* SPI1 on the 40-pin header through the Tegra SPI controller, pins through sysfs */
+static const DEV_HAL DEV_HAL_JETSON_SPIDEV = {
+	"spidev/sysfs", DEV_SYSFS_Write, DEV_SYSFS_Read, DEV_SPIDEV_Transfer, DEV_Wait_DRDY_Poll, DEV_Sleep_us, DEV_SPIDEV_Transfer_Chain,
+};
 #endif
 #endif
-	return Read_value;
+
+static DEV_HAL DEV_Hal_Ops = {
+	"none", DEV_None_Write, DEV_None_Read, DEV_None_Transfer, DEV_Wait_DRDY_Poll, DEV_Sleep_us, DEV_Loop_Transfer_Chain,
+};
+
+/******************************************************************************
+function:	Install a HAL
+parameter:
+	Hal : ops table, copied; NULL restores the "none" stubs
+Info:
+	Called by DEV_Module_Init. Also lets a caller plug in a backend of its
+	own, after DEV_Module_Init or instead of it. A table without
+	spi_transfer_chain sends chains one spi_transfer_buf at a time, one
+	without delay_ms sleeps through delay_us.
+******************************************************************************/
+void DEV_Set_HAL(const DEV_HAL *Hal)
+{
+	DEV_Hal_Ops = Hal != NULL ? *Hal : DEV_HAL_None;
+	if (DEV_Hal_Ops.spi_transfer_chain == NULL) {
+		DEV_Hal_Ops.spi_transfer_chain = DEV_Loop_Transfer_Chain;
+	}
+}
+
+/**
+ * GPIO read and write
+**/
+void DEV_Digital_Write(UWORD Pin, UBYTE Value)
+{
+	DEV_Hal_Ops.gpio_write(Pin, Value);
+}
+
+UBYTE DEV_Digital_Read(UWORD Pin)
+{
+	return DEV_Hal_Ops.gpio_read(Pin);
+}
+
+/******************************************************************************
+function:	Wait for DRDY to go low
+parameter:
+	Port       : board
+	Timeout_us : give up after this many microseconds
+Info:
+	Blocks on a gpiochip falling-edge event when DEV_Port_Init could
+	request one, otherwise polls the pin against CLOCK_MONOTONIC.
+	Return 0 DRDY low
+	Return 1 timeout
+******************************************************************************/
+UBYTE DEV_Port_Wait_DRDY(DEV_PORT *Port, UDOUBLE Timeout_us)
+{
+	return DEV_Hal_Ops.wait_drdy(Port, Timeout_us);
+}
+
+UBYTE DEV_Wait_DRDY(UDOUBLE Timeout_us)
+{
+	return DEV_Hal_Ops.wait_drdy(&DEV_Port0, Timeout_us);
+}
+
+/******************************************************************************
+function:	Read the DRDY level
+parameter:
+	Port : board
+Info:
+	Reads the event line when DEV_Port_Init could request one. The line
+	then holds the pin and sysfs no longer has it, so use this rather
+	than DEV_Digital_Read for DRDY.
+	Return 0 low (data ready), 1 high
+******************************************************************************/
+UBYTE DEV_Port_Read_DRDY(DEV_PORT *Port)
+{
+	if (Port->DRDY.fd >= 0) {
+		return DEV_GPIO_EVENT_Read(&Port->DRDY) != 0;
+	}
+	return DEV_Hal_Ops.gpio_read(Port->DRDY_PIN);
+}
+
+UBYTE DEV_Read_DRDY(void)
+{
+	return DEV_Port_Read_DRDY(&DEV_Port0);
+}
+
+/* installed once any board has an event line; boards without one still poll */
+static UBYTE DEV_Wait_DRDY_Event(DEV_PORT *Port, UDOUBLE Timeout_us)
+{
+	if (Port->DRDY.fd < 0) {
+		return DEV_Wait_DRDY_Poll(Port, Timeout_us);
+	}
+	return DEV_GPIO_EVENT_WaitLow(&Port->DRDY, Timeout_us) == 1 ? 0 : 1;
+}
+
+static UBYTE DEV_Wait_DRDY_Poll(DEV_PORT *Port, UDOUBLE Timeout_us)
+{
+	struct timespec start, now;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while(DEV_Hal_Ops.gpio_read(Port->DRDY_PIN) != 0) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if((UDOUBLE)((now.tv_sec - start.tv_sec) * 1000000 + (now.tv_nsec - start.tv_nsec) / 1000) >= Timeout_us) {
+			return 1;
+		}
+	}
+	return 0;
 }
 
 /**
@@ -125,32 +452,10 @@ UBYTE DEV_Digital_Read(UWORD Pin)
 **/
 UBYTE DEV_SPI_WriteByte(uint8_t Value)
 {
-	UBYTE temp = 0;
 	// printf("write %x \r\n", Value);
-#ifdef RPI
-#ifdef USE_BCM2835_LIB
-	if (use_bcm2835) {
-		temp = bcm2835_spi_transfer(Value);
-	} else {
-		temp = DEV_HARDWARE_SPI_TransferByte(Value);
-	}
-#elif USE_WIRINGPI_LIB
-	wiringPiSPIDataRW(0, &Value, 1);
-	temp = Value;
-#elif USE_DEV_LIB
-	temp = DEV_HARDWARE_SPI_TransferByte(Value);
-#endif
-#endif
-
-#ifdef JETSON
-#ifdef USE_DEV_LIB
-	temp = SYSFS_software_spi_transfer(Value);
-#elif USE_HARDWARE_LIB
-	Debug("not support");
-#endif
-#endif
-	// printf("Read %x \r\n", temp);
-	return temp;
+	DEV_Hal_Ops.spi_transfer_buf(&DEV_Port0, &Value, 1);
+	// printf("Read %x \r\n", Value);
+	return Value;
 }
 
 UBYTE DEV_SPI_ReadByte(void)
@@ -158,6 +463,60 @@ UBYTE DEV_SPI_ReadByte(void)
 	return DEV_SPI_WriteByte(0x00);
 }
 
+/******************************************************************************
+function:	Full-duplex SPI transfer of a whole frame
+parameter:
+	Port : board; chip select is the caller's, through Port->CS_PIN
+	Buf  : bytes to send, overwritten with the bytes received
+	Len  : frame length
+Info:
+	One bcm2835 FIFO run or one spidev ioctl per frame instead of one per byte
+******************************************************************************/
+void DEV_Port_Transfer(DEV_PORT *Port, UBYTE *Buf, UDOUBLE Len)
+{
+	DEV_Hal_Ops.spi_transfer_buf(Port, Buf, Len);
+}
+
+void DEV_SPI_Transfer(UBYTE *Buf, UDOUBLE Len)
+{
+	DEV_Hal_Ops.spi_transfer_buf(&DEV_Port0, Buf, Len);
+}
+
+/******************************************************************************
+function:	Several frames back to back under one chip select
+parameter:
+	Port   : board; CS is the caller's, as for DEV_Port_Transfer
+	Xfer   : frames, each sent and received in place
+	Number : frame count, up to DEV_SPI_MAXCHAIN
+Info:
+	On spidev the chain is a single SPI_IOC_MESSAGE(N) ioctl instead of
+	one syscall per frame. Other backends send the frames in turn.
+******************************************************************************/
+void DEV_Port_Transfer_Chain(DEV_PORT *Port, DEV_SPI_XFER *Xfer, UBYTE Number)
+{
+	DEV_Hal_Ops.spi_transfer_chain(Port, Xfer, Number);
+}
+
+/******************************************************************************
+function:	Take and release the SPI bus of a board
+parameter:
+	Port : board
+Info:
+	Boards on one SPI controller share SCLK/MOSI/MISO and are selected
+	with a GPIO, so a board whose CS is low reads every other board's
+	traffic as its own. Ports on other controllers hold other locks. Hold the lock from CS low to CS high whenever more than
+	one thread talks to the boards.
+******************************************************************************/
+void DEV_Port_Lock(DEV_PORT *Port)
+{
+	pthread_mutex_lock(Port->Bus);
+}
+
+void DEV_Port_Unlock(DEV_PORT *Port)
+{
+	pthread_mutex_unlock(Port->Bus);
+}
+
 /**
  * GPIO Mode
 **/
@@ -171,6 +530,8 @@ void DEV_GPIO_Mode(UWORD Pin, UWORD Mode)
 		} else {
 			bcm2835_gpio_fsel(Pin, BCM2835_GPIO_FSEL_OUTP);
 		}
+	} else if (use_rp1) {
+		RP1_GPIO_Mode(Pin, (Mode == 0 || Mode == SYSFS_GPIO_IN) ? RP1_GPIO_IN : RP1_GPIO_OUT);
 	} else {
 		SYSFS_GPIO_Export(Pin);
 		if(Mode == 0 || Mode == SYSFS_GPIO_IN) {
@@ -187,6 +548,10 @@ void DEV_GPIO_Mode(UWORD Pin, UWORD Mode)
 		pinMode(Pin, OUTPUT);
 	}
 #elif USE_DEV_LIB
+	if (use_rp1) {
+		RP1_GPIO_Mode(Pin, (Mode == 0 || Mode == SYSFS_GPIO_IN) ? RP1_GPIO_IN : RP1_GPIO_OUT);
+		return;
+	}
 	SYSFS_GPIO_Export(Pin);
 	if(Mode == 0 || Mode == SYSFS_GPIO_IN) {
 		SYSFS_GPIO_Direction(Pin, SYSFS_GPIO_IN);
@@ -197,75 +562,55 @@ void DEV_GPIO_Mode(UWORD Pin, UWORD Mode)
 #endif
 
 #ifdef JETSON
-#ifdef USE_DEV_LIB
 	SYSFS_GPIO_Export(Pin);
 	SYSFS_GPIO_Direction(Pin, Mode);
-#elif USE_HARDWARE_LIB
-	Debug("not support");
-#endif
 #endif
 }
 
 /**
- * delay x ms
+ * delay x us / x ms
+ * bcm2835 and wiringPi bring their own, the others use DEV_Sleep_us;
+ * without a millisecond op, long delays go in 1 s steps so xms * 1000
+ * neither overflows nor leaves the range of one sleep
 **/
+void DEV_Delay_us(UDOUBLE xus)
+{
+	DEV_Hal_Ops.delay_us(xus);
+}
+
 void DEV_Delay_ms(UDOUBLE xms)
 {
-#ifdef RPI
-#ifdef USE_BCM2835_LIB
-	if (use_bcm2835) {
-		bcm2835_delay(xms);
-	} else {
-		UDOUBLE i;
-		for(i=0; i < xms; i++) {
-			usleep(1000);
-		}
+	if (DEV_Hal_Ops.delay_ms != NULL) {
+		DEV_Hal_Ops.delay_ms(xms);
+		return;
 	}
-#elif USE_WIRINGPI_LIB
-	delay(xms);
-#elif USE_DEV_LIB
-	UDOUBLE i;
-	for(i=0; i < xms; i++) {
-		usleep(1000);
+	for (; xms > 1000; xms -= 1000) {
+		DEV_Hal_Ops.delay_us(1000000);
 	}
-#endif
-#endif
-
-#ifdef JETSON
-	UDOUBLE i;
-	for(i=0; i < xms; i++) {
-		usleep(1000);
-	}
-#endif
+	DEV_Hal_Ops.delay_us(xms * 1000);
 }
 
 static int DEV_Equipment_Testing(void)
 {
-	int i;
+	int i, n;
 	int fd;
-	char value_str[20];
+	char value_str[64];
 	fd = open("/etc/issue", O_RDONLY);
     printf("Current environment: ");
-	while(1) {
-		if (fd < 0) {
-			Debug( "Read failed Pin\n");
-			return -1;
-		}
-		for(i=0;; i++) {
-			if (read(fd, &value_str[i], 1) < 0) {
-				Debug( "failed to read value!\n");
-				return -1;
-			}
-			if(value_str[i] ==32) {
-				printf("\r\n");
-				/* null-terminate the string we read (stop at first space) */
-				value_str[i] = '\0';
-				break;
-			}
-			printf("%c",value_str[i]);
-		}
-		break;
+	if (fd < 0) {
+		Debug( "Read failed Pin\n");
+		return -1;
 	}
+	/* one read, the OS name is the first word */
+	n = read(fd, value_str, sizeof(value_str) - 1);
+	close(fd);
+	if (n < 0) {
+		Debug( "failed to read value!\n");
+		return -1;
+	}
+	for(i=0; i<n && value_str[i] != ' ' && value_str[i] != '\n'; i++);
+	value_str[i] = '\0';
+	printf("%s\r\n", value_str);
 #ifdef RPI
 	if(i<1) {
 		printf("Unrecognizable\r\n");
@@ -294,24 +639,189 @@ static int DEV_Equipment_Testing(void)
 	return 0;
 }
 
-void DEV_GPIO_Init(void)
+/******************************************************************************
+function:	The pins are exported through sysfs by DEV_GPIO_Mode
+parameter:
+Info:
+******************************************************************************/
+static int DEV_Uses_Sysfs(void)
 {
 #ifdef RPI
-	DEV_RST_PIN     = 18;
-	DEV_CS_PIN      = 22;
-	DEV_DRDY_PIN    = 17;
+#ifdef USE_BCM2835_LIB
+	return !use_bcm2835 && !use_rp1;
+#elif USE_DEV_LIB
+	return !use_rp1;
+#endif
 #elif JETSON
-	DEV_RST_PIN     = GPIO18;
-	DEV_CS_PIN      = GPIO22;
-	DEV_DRDY_PIN    = GPIO17;
+	return 1;
 #endif
+	return 0;
+}
 
-	DEV_GPIO_Mode(DEV_RST_PIN, 1);
-	DEV_GPIO_Mode(DEV_CS_PIN, 1);
-	
-	DEV_GPIO_Mode(DEV_DRDY_PIN, 0);
-	
-	DEV_Digital_Write(DEV_CS_PIN, 1);
+/******************************************************************************
+function:	Move DRDY onto a gpiochip falling-edge event line
+parameter:
+	Port     : board whose DRDY pin is set up
+	Exported : DRDY is currently exported through sysfs
+Info:
+	The kernel refuses to hand out a line that sysfs holds, so an exported
+	DRDY is unexported first and exported again if the request fails.
+******************************************************************************/
+static void DEV_DRDY_Event_Init(DEV_PORT *Port, UBYTE Exported)
+{
+#ifdef RPI
+	const char *Labels[] = {"pinctrl-rp1", "pinctrl-bcm2711", "pinctrl-bcm2835"};
+	UBYTE i;
+	if (Exported) {
+		SYSFS_GPIO_Unexport(Port->DRDY_PIN);
+	}
+	for(i=0; i < sizeof(Labels) / sizeof(Labels[0]); i++) {
+		if (DEV_GPIO_EVENT_Begin(&Port->DRDY, Labels[i], Port->DRDY_PIN - gpio_sysfs_offset) == 0) {
+			break;
+		}
+	}
+	if (!DEV_GPIO_EVENT_IsOpen(&Port->DRDY) && Exported) {
+		SYSFS_GPIO_Export(Port->DRDY_PIN);
+		SYSFS_GPIO_Direction(Port->DRDY_PIN, SYSFS_GPIO_IN);
+	}
+#elif JETSON
+	if (Exported) {
+		SYSFS_GPIO_Unexport(Port->DRDY_PIN);
+	}
+	DEV_GPIO_EVENT_BeginSysfs(&Port->DRDY, Port->DRDY_PIN);
+	if (!DEV_GPIO_EVENT_IsOpen(&Port->DRDY) && Exported) {
+		SYSFS_GPIO_Export(Port->DRDY_PIN);
+		SYSFS_GPIO_Direction(Port->DRDY_PIN, IN);
+	}
+#endif
+	if (DEV_GPIO_EVENT_IsOpen(&Port->DRDY)) {
+		/* a HAL installed with DEV_Set_HAL keeps its own wait */
+		if (DEV_Hal_Ops.wait_drdy == DEV_Wait_DRDY_Poll) {
+			DEV_Hal_Ops.wait_drdy = DEV_Wait_DRDY_Event;
+		}
+		printf("DRDY: gpiochip falling-edge events\r\n");
+	} else {
+		printf("DRDY: polled\r\n");
+	}
+}
+
+/******************************************************************************
+function:	Bus lock for a spidev node
+parameter:
+	SPI_device : /dev/spidevB.C
+Info:
+	Boards on one controller share SCLK/MOSI/MISO whatever chip select they
+	use; boards on different controllers never meet and get apart locks.
+	A name that does not parse falls back to bus 0.
+******************************************************************************/
+static pthread_mutex_t *DEV_Bus_Lock(const char *SPI_device)
+{
+	int Bus, Cs;
+
+	if (SPI_device == NULL || sscanf(SPI_device, "/dev/spidev%d.%d", &Bus, &Cs) != 2
+		|| Bus < 0 || Bus >= DEV_SPI_MAXBUS) {
+		Debug("DEV_Bus_Lock: %s, using bus 0\r\n", SPI_device ? SPI_device : "(null)");
+		return &DEV_SPI_Bus[0];
+	}
+	return &DEV_SPI_Bus[Bus];
+}
+
+/******************************************************************************
+function:	Set up one board
+parameter:
+	Port       : board to fill
+	SPI_device : spidev node, e.g. /dev/spidev0.1; ignored where the
+	             backend drives a single bus (bcm2835, wiringPi, software SPI)
+	RST_PIN    : pin numbers, BCM on the Pi, sysfs numbers on Jetson
+	CS_PIN     :
+	DRDY_PIN   :
+Info:
+	DEV_Module_Init picks the backend and sets up DEV_Port0; further
+	boards stacked on the same host are added with this call after it.
+	Every board needs its own CS and DRDY pins; on a shared bus the CS
+	pin alone tells the boards apart.
+	Return 0 success, 1 the SPI device could not be opened
+******************************************************************************/
+UBYTE DEV_Port_Init(DEV_PORT *Port, char *SPI_device, int RST_PIN, int CS_PIN, int DRDY_PIN)
+{
+	int Offset = DEV_Uses_Sysfs() ? gpio_sysfs_offset : 0;
+
+	Port->RST_PIN   = RST_PIN + Offset;
+	Port->CS_PIN    = CS_PIN == DEV_CS_HARDWARE ? DEV_CS_HARDWARE : CS_PIN + Offset;
+	Port->DRDY_PIN  = DRDY_PIN + Offset;
+	Port->SPI_fd    = -1;
+	Port->DRDY.fd   = -1;
+	Port->DRDY.line = 0;
+	Port->Bus       = &DEV_SPI_Bus[0];
+
+#if defined(RPI) && (defined(USE_BCM2835_LIB) || defined(USE_DEV_LIB))
+	if (!use_bcm2835) {
+		Port->SPI_fd = DEV_HARDWARE_SPI_Open(SPI_device, SPI_MODE1, 1000000);
+		if (Port->SPI_fd < 0) {
+			printf("Failed to open SPI device %s\r\n", SPI_device);
+			return 1;
+		}
+	}
+#endif
+#if defined(JETSON) && defined(USE_HARDWARE_LIB)
+	if (!use_softspi) {
+		Port->SPI_fd = DEV_HARDWARE_SPI_Open(SPI_device, SPI_MODE1, 1000000);
+		if (Port->SPI_fd < 0) {
+			printf("Failed to open SPI device %s\r\n", SPI_device);
+			return 1;
+		}
+	}
+#endif
+	if (Port->CS_PIN == DEV_CS_HARDWARE && Port->SPI_fd < 0) {
+		printf("Hardware CS needs a spidev backend\r\n");
+		return 1;
+	}
+	if (Port->SPI_fd >= 0) {
+		Port->Bus = DEV_Bus_Lock(SPI_device);
+	}
+
+	DEV_GPIO_Mode(Port->RST_PIN, 1);
+	DEV_GPIO_Mode(Port->DRDY_PIN, 0);
+	if (Port->CS_PIN != DEV_CS_HARDWARE) {
+		DEV_GPIO_Mode(Port->CS_PIN, 1);
+		DEV_Digital_Write(Port->CS_PIN, 1);
+	}
+
+	DEV_DRDY_Event_Init(Port, DEV_Uses_Sysfs());
+	return 0;
+}
+
+/******************************************************************************
+function:	Release one board
+parameter:
+	Port : board set up with DEV_Port_Init
+Info:
+	Extra boards go before DEV_Module_Exit, which releases DEV_Port0
+******************************************************************************/
+void DEV_Port_Exit(DEV_PORT *Port)
+{
+	DEV_GPIO_EVENT_End(&Port->DRDY);
+#ifdef RPI
+	DEV_Digital_Write(Port->RST_PIN, 0);
+	if (Port->CS_PIN != DEV_CS_HARDWARE) {
+		DEV_Digital_Write(Port->CS_PIN, 0);
+	}
+#if defined(USE_BCM2835_LIB) || defined(USE_DEV_LIB)
+	DEV_HARDWARE_SPI_Close(Port->SPI_fd);
+	Port->SPI_fd = -1;
+#endif
+
+#elif JETSON
+	SYSFS_GPIO_Unexport(Port->RST_PIN);
+	if (Port->CS_PIN != DEV_CS_HARDWARE) {
+		SYSFS_GPIO_Unexport(Port->CS_PIN);
+	}
+	SYSFS_GPIO_Unexport(Port->DRDY_PIN);
+#ifdef USE_HARDWARE_LIB
+	DEV_HARDWARE_SPI_Close(Port->SPI_fd);
+	Port->SPI_fd = -1;
+#endif
+#endif
 }
 
 /******************************************************************************
@@ -325,52 +835,55 @@ UBYTE DEV_Module_Init(void)
 	if(DEV_Equipment_Testing() < 0) {
 		return 1;
 	}
+	DEV_Delay_Calibrate();
 #ifdef RPI
 #ifdef USE_BCM2835_LIB
 	if(!bcm2835_init()) {
 		printf("bcm2835_init failed; attempting fallback to /dev/spidev...\r\n");
 		use_bcm2835 = 0;
-		/* Detect Pi 5 GPIO offset (571 for Pi 5, 0 for earlier) */
-		gpio_sysfs_offset = detect_pi5_gpio_offset();
-		if (gpio_sysfs_offset > 0) {
-			printf("Raspberry Pi 5 detected: using GPIO offset %d\r\n", gpio_sysfs_offset);
+		if (RP1_GPIO_Begin() == 0) {
+			/* Pi 5: RP1 registers, BCM pin numbers */
+			use_rp1 = 1;
+			DEV_Set_HAL(&DEV_HAL_RP1);
+		} else {
+			DEV_Set_HAL(&DEV_HAL_SYSFS);
+			/* Detect Pi 5 GPIO offset (571 for Pi 5, 0 for earlier) */
+			gpio_sysfs_offset = detect_pi5_gpio_offset();
+			if (gpio_sysfs_offset > 0) {
+				printf("Raspberry Pi 5 detected: using GPIO offset %d\r\n", gpio_sysfs_offset);
+			}
 		}
-		/* Try using spidev-based hardware SPI as a fallback */
-		/* Initialize GPIOs using sysfs with Pi 5 offset */
-		DEV_RST_PIN     = 18 + gpio_sysfs_offset;
-		DEV_CS_PIN      = 22 + gpio_sysfs_offset;
-		DEV_DRDY_PIN    = 17 + gpio_sysfs_offset;
-		SYSFS_GPIO_Export(DEV_RST_PIN);
-		SYSFS_GPIO_Export(DEV_CS_PIN);
-		SYSFS_GPIO_Export(DEV_DRDY_PIN);
-		SYSFS_GPIO_Direction(DEV_RST_PIN, SYSFS_GPIO_OUT);
-		SYSFS_GPIO_Direction(DEV_CS_PIN, SYSFS_GPIO_OUT);
-		SYSFS_GPIO_Direction(DEV_DRDY_PIN, SYSFS_GPIO_IN);
-		DEV_HARDWARE_SPI_begin("/dev/spidev0.0");
-		DEV_HARDWARE_SPI_setSpeed(1000000);
-		DEV_HARDWARE_SPI_Mode(SPI_MODE_1);
 	} else {
 		printf("bcm2835 init success !!! \r\n");
 		use_bcm2835 = 1;
-
-		/* GPIO Config */
-		DEV_GPIO_Init();
+		DEV_Set_HAL(&DEV_HAL_BCM2835);
 
 		bcm2835_spi_begin();                                         //Start spi interface, set spi pin for the reuse function
 		bcm2835_spi_setBitOrder(BCM2835_SPI_BIT_ORDER_MSBFIRST);     //High first transmission
 		bcm2835_spi_setDataMode(BCM2835_SPI_MODE1);                  //spi mode 1, '0, 1'
 		bcm2835_spi_setClockDivider(BCM2835_SPI_CLOCK_DIVIDER_32);  //Frequency
 	}
+	/* GPIO Config; the fallbacks use spidev, sysfs pins take the Pi 5 offset */
+	if (DEV_Port_Init(&DEV_Port0, "/dev/spidev0.0", 18, use_bcm2835 ? 22 : DEV_PORT0_CS, 17) != 0) {
+		return 1;
+	}
 	/* Runtime diagnostics */
 	if (use_bcm2835) {
 		printf("Runtime backend: bcm2835 (direct /dev/gpiomem)\r\n");
 		printf("GPIO pins: RST=%d CS=%d DRDY=%d\r\n", DEV_RST_PIN, DEV_CS_PIN, DEV_DRDY_PIN);
 		printf("SPI: bcm2835 mode, clock divider set by bcm2835 library\r\n");
+	} else if (use_rp1) {
+		printf("Runtime backend: spidev/RP1 fallback\r\n");
+		printf("Using SPI device: /dev/spidev0.0 at 1MHz (configured)\r\n");
+		printf("GPIO via %s: RST=%d CS=%d DRDY=%d\r\n", RP1_GPIOMEM, DEV_RST_PIN, DEV_CS_PIN, DEV_DRDY_PIN);
 	} else {
 		printf("Runtime backend: spidev/sysfs fallback\r\n");
 		printf("Using SPI device: /dev/spidev0.0 at 1MHz (configured)\r\n");
 		printf("GPIO via sysfs: RST=%d CS=%d DRDY=%d\r\n", DEV_RST_PIN, DEV_CS_PIN, DEV_DRDY_PIN);
 	}
+	if (DEV_CS_PIN == DEV_CS_HARDWARE) {
+		printf("CS: spidev hardware chip select\r\n");
+	}
 #elif USE_WIRINGPI_LIB
 	// if(wiringPiSetup() < 0) {//use wiringpi Pin number table
 	if(wiringPiSetupGpio() < 0) { //use BCM2835 Pin number table
@@ -379,32 +892,56 @@ UBYTE DEV_Module_Init(void)
 	} else {
 		printf("set wiringPi lib success !!! \r\n");
 	}
+	DEV_Set_HAL(&DEV_HAL_WIRINGPI);
 
 	// GPIO Config
-	DEV_GPIO_Init();
+	DEV_Port_Init(&DEV_Port0, NULL, 18, 22, 17);
 	// wiringPiSPISetup(0,10000000);
 	wiringPiSPISetupMode(0, 1000000, 1);
 #elif USE_DEV_LIB
 	printf("Write and read /dev/spidev0.0 \r\n");
-	DEV_GPIO_Init();
-	DEV_HARDWARE_SPI_begin("/dev/spidev0.0");
-    DEV_HARDWARE_SPI_setSpeed(1000000);
-	DEV_HARDWARE_SPI_Mode(SPI_MODE_1);
+	if (RP1_GPIO_Begin() == 0) {
+		use_rp1 = 1;
+		DEV_Set_HAL(&DEV_HAL_RP1);
+		printf("GPIO via %s\r\n", RP1_GPIOMEM);
+	} else {
+		DEV_Set_HAL(&DEV_HAL_SYSFS);
+	}
+	if (DEV_Port_Init(&DEV_Port0, "/dev/spidev0.0", 18, DEV_PORT0_CS, 17) != 0) {
+		return 1;
+	}
+	if (DEV_CS_PIN == DEV_CS_HARDWARE) {
+		printf("CS: spidev hardware chip select\r\n");
+	}
 #endif
 
 
 #elif JETSON
 #ifdef USE_DEV_LIB
-	DEV_GPIO_Init();
+	DEV_Set_HAL(&DEV_HAL_SYSFS);
+	DEV_Port_Init(&DEV_Port0, NULL, GPIO18, GPIO22, GPIO17);
 	printf("Software spi\r\n");
 	SYSFS_software_spi_begin();
 	SYSFS_software_spi_setBitOrder(SOFTWARE_SPI_MSBFIRST);
 	SYSFS_software_spi_setDataMode(SOFTWARE_SPI_Mode1);
 	SYSFS_software_spi_setClockDivider(SOFTWARE_SPI_CLOCK_DIV16);
 #elif USE_HARDWARE_LIB
-	printf("Write and read /dev/spidev0.0 \r\n");
-	DEV_GPIO_Init();
-	DEV_HARDWARE_SPI_begin("/dev/spidev0.0");
+	/* spidev0.0 is SPI1 on pins 19/21/23/24 once enabled with jetson-io */
+	DEV_Set_HAL(&DEV_HAL_JETSON_SPIDEV);
+	if (DEV_Port_Init(&DEV_Port0, "/dev/spidev0.0", GPIO18, GPIO22, GPIO17) == 0) {
+		printf("Runtime backend: spidev/sysfs\r\n");
+		printf("Using SPI device: /dev/spidev0.0 at 1MHz (configured)\r\n");
+	} else {
+		printf("no spidev, falling back to software spi\r\n");
+		use_softspi = 1;
+		DEV_Set_HAL(&DEV_HAL_SYSFS);
+		DEV_Port_Init(&DEV_Port0, NULL, GPIO18, GPIO22, GPIO17);
+		SYSFS_software_spi_begin();
+		SYSFS_software_spi_setBitOrder(SOFTWARE_SPI_MSBFIRST);
+		SYSFS_software_spi_setDataMode(SOFTWARE_SPI_Mode1);
+		SYSFS_software_spi_setClockDivider(SOFTWARE_SPI_CLOCK_DIV16);
+	}
+	printf("GPIO via sysfs: RST=%d CS=%d DRDY=%d\r\n", DEV_RST_PIN, DEV_CS_PIN, DEV_DRDY_PIN);
 #endif
 
 #endif
@@ -412,6 +949,17 @@ UBYTE DEV_Module_Init(void)
 	return 0;
 }
 
+/******************************************************************************
+function:	Name of the GPIO/SPI backend in use
+parameter:
+Info:
+	The ops table DEV_Module_Init picked among the backends compiled in
+******************************************************************************/
+const char *DEV_Backend(void)
+{
+	return DEV_Hal_Ops.Name;
+}
+
 /******************************************************************************
 function:	Module exits, closes SPI and BCM2835 library
 parameter:
@@ -419,33 +967,24 @@ Info:
 ******************************************************************************/
 void DEV_Module_Exit(void)
 {
+	DEV_Port_Exit(&DEV_Port0);
 #ifdef RPI
 #ifdef USE_BCM2835_LIB
-	DEV_Digital_Write(DEV_RST_PIN, LOW);
-	DEV_Digital_Write(DEV_CS_PIN, LOW);
 	if (use_bcm2835) {
 		bcm2835_spi_end();
 		bcm2835_close();
 	} else {
-		DEV_HARDWARE_SPI_end();
+		RP1_GPIO_End();
 	}
-#elif USE_WIRINGPI_LIB
-	DEV_Digital_Write(DEV_RST_PIN, 0);
-	DEV_Digital_Write(DEV_CS_PIN, 0);
 #elif USE_DEV_LIB
-	DEV_HARDWARE_SPI_end();
-	DEV_Digital_Write(DEV_RST_PIN, 0);
-	DEV_Digital_Write(DEV_CS_PIN, 0);
+	RP1_GPIO_End();
 #endif
 
 #elif JETSON
-#ifdef USE_DEV_LIB
-	SYSFS_GPIO_Unexport(DEV_RST_PIN);
-	SYSFS_GPIO_Unexport(DEV_CS_PIN);
-	SYSFS_GPIO_Unexport(DEV_DRDY_PIN);
-
-#elif USE_HARDWARE_LIB
-	Debug("not support");
+#ifdef USE_HARDWARE_LIB
+	if (use_softspi) {
+		SYSFS_software_spi_end();
+	}
 #endif
 #endif
 }
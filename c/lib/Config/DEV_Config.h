@@ -38,7 +38,9 @@
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 #include "Debug.h"
+#include "dev_gpio_event.h"
 
 #ifdef RPI
     #ifdef USE_BCM2835_LIB
@@ -53,13 +55,11 @@
 #endif
 
 #ifdef JETSON
-    #ifdef USE_DEV_LIB
-        #include "sysfs_gpio.h"    
-        #include "sysfs_software_spi.h"
-    #elif USE_HARDWARE_LIB
-        
+    #include "sysfs_gpio.h"
+    #include "sysfs_software_spi.h"
+    #ifdef USE_HARDWARE_LIB
+        #include "dev_hardware_SPI.h"
     #endif
-
 #endif
 
 /**
@@ -70,21 +70,79 @@
 #define UDOUBLE uint32_t
 
 /**
- * GPIOI config
+ * One board: its pins, its SPI device and its DRDY event line
+**/
+typedef struct DEV_PortStruct {
+    int RST_PIN;
+    int CS_PIN;         // DEV_CS_HARDWARE: spidev frames CS, no GPIO
+    int DRDY_PIN;
+    int SPI_fd;         // own spidev node, -1 where all boards share one bus (bcm2835, wiringPi, software SPI)
+    GPIO_EVENT DRDY;    // falling-edge line, fd -1 while DRDY is polled
+    pthread_mutex_t *Bus;   // held from CS low to CS high, see DEV_Port_Lock
+} DEV_PORT;
+
+/**
+ * CS_PIN for DEV_Port_Init: the kernel drives the spidev node's own chip
+ * select around every transfer (or chain), the driver drives no GPIO
+**/
+#define DEV_CS_HARDWARE     (-1)
+
+/**
+ * One transfer of a chain, see DEV_Port_Transfer_Chain
 **/
-extern int DEV_RST_PIN;
-extern int DEV_CS_PIN;
-extern int DEV_DRDY_PIN;
+#define DEV_SPI_MAXCHAIN    8
+
+typedef struct {
+    UBYTE *Buf;         // bytes to send, overwritten with the bytes received
+    UDOUBLE Len;
+} DEV_SPI_XFER;
+
+/**
+ * HAL ops, picked once in DEV_Module_Init
+**/
+typedef struct {
+    const char *Name;
+    void (*gpio_write)(UWORD Pin, UBYTE Value);
+    UBYTE (*gpio_read)(UWORD Pin);
+    void (*spi_transfer_buf)(DEV_PORT *Port, UBYTE *Buf, UDOUBLE Len);    // full duplex, in place
+    UBYTE (*wait_drdy)(DEV_PORT *Port, UDOUBLE Timeout_us);                // 0 DRDY low, 1 timeout
+    void (*delay_us)(UDOUBLE xus);
+    void (*spi_transfer_chain)(DEV_PORT *Port, DEV_SPI_XFER *Xfer, UBYTE Number);  // NULL: one spi_transfer_buf each
+    void (*delay_ms)(UDOUBLE xms);                                          // NULL: delay_us, 1 s at a time
+} DEV_HAL;
+
+/**
+ * GPIOI config: the board DEV_Module_Init sets up on the HAT's own pins
+**/
+extern DEV_PORT DEV_Port0;
+#define DEV_RST_PIN     DEV_Port0.RST_PIN
+#define DEV_CS_PIN      DEV_Port0.CS_PIN
+#define DEV_DRDY_PIN    DEV_Port0.DRDY_PIN
 
 /*------------------------------------------------------------------------------------------------------*/
 void DEV_Digital_Write(UWORD Pin, UBYTE Value);
 UBYTE DEV_Digital_Read(UWORD Pin);
+UBYTE DEV_Wait_DRDY(UDOUBLE Timeout_us);
+UBYTE DEV_Read_DRDY(void);
 
 UBYTE DEV_SPI_WriteByte(UBYTE Value);
 UBYTE DEV_SPI_ReadByte(void);
+void DEV_SPI_Transfer(UBYTE *Buf, UDOUBLE Len);
+
+UBYTE DEV_Port_Init(DEV_PORT *Port, char *SPI_device, int RST_PIN, int CS_PIN, int DRDY_PIN);
+void DEV_Port_Exit(DEV_PORT *Port);
+void DEV_Port_Transfer(DEV_PORT *Port, UBYTE *Buf, UDOUBLE Len);
+void DEV_Port_Transfer_Chain(DEV_PORT *Port, DEV_SPI_XFER *Xfer, UBYTE Number);
+UBYTE DEV_Port_Wait_DRDY(DEV_PORT *Port, UDOUBLE Timeout_us);
+UBYTE DEV_Port_Read_DRDY(DEV_PORT *Port);
+void DEV_Port_Lock(DEV_PORT *Port);
+void DEV_Port_Unlock(DEV_PORT *Port);
 
 UBYTE DEV_Module_Init(void);
 void DEV_Module_Exit(void);
+const char *DEV_Backend(void);
+void DEV_Set_HAL(const DEV_HAL *Hal);
 
 void DEV_Delay_ms(UDOUBLE xms);
+void DEV_Delay_us(UDOUBLE xus);
 #endif
@@ -11,6 +11,14 @@
 * | Info        :   
 *   1.USE_DEBUG -> DEBUG, If you need to see the debug information, 
 *    clear the execution: make DEBUG=-DDEBUG
+*----------------
+* |	This version:   V2.1
+* | Date        :   2026-10-14
+* | Info        :
+*   1.Log_Error/Log_Warn/Log_Info/Log_Debug, LOG_LEVEL picks what is
+*     compiled in: make LOG_LEVEL=0 removes all of them
+*   2.Log_xxx_Limit: at most LOG_LIMIT_BURST messages per second from
+*     one call site, for errors that can repeat at the sample rate
 #
 # Permission is hereby granted, free of charge, to any person obtaining a copy
 # of this software and associated documnetation files (the "Software"), to deal
@@ -36,6 +44,9 @@
 #define __DEBUG_H
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
 
 #if DEBUG
 	#define Debug(__info,...) printf("Debug: " __info,##__VA_ARGS__)
@@ -43,5 +54,96 @@
 	#define Debug(__info,...)  
 #endif
 
+/**
+ * Log levels, a message is compiled in if its level <= LOG_LEVEL
+**/
+#define LOG_LEVEL_NONE		0
+#define LOG_LEVEL_ERROR		1
+#define LOG_LEVEL_WARN		2
+#define LOG_LEVEL_INFO		3
+#define LOG_LEVEL_DEBUG		4
+
+#ifndef LOG_LEVEL
+	#if DEBUG
+		#define LOG_LEVEL	LOG_LEVEL_DEBUG
+	#else
+		#define LOG_LEVEL	LOG_LEVEL_WARN
+	#endif
+#endif
+
+#define LOG_LIMIT_BURST		5			// messages per call site and second
+
+/**
+ * Rate limit state, one per call site
+**/
+typedef struct {
+	atomic_ullong Window;		// second the burst belongs to
+	atomic_uint Count;			// messages in that second
+	atomic_uint Dropped;		// suppressed since the last one printed
+} LOG_LIMIT;
+
+/******************************************************************************
+function:	Decide whether a rate limited message goes out
+parameter:
+	Limit : call site state
+Info:
+	Returns the number of messages suppressed before this one plus 1,
+	0 to drop it. Counts can be off by one between threads, never more.
+******************************************************************************/
+static inline unsigned Log_Allow(LOG_LIMIT *Limit)
+{
+	struct timespec ts;
+	unsigned long long now;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (unsigned long long)ts.tv_sec;
+	if(atomic_exchange_explicit(&Limit->Window, now, memory_order_relaxed) != now)
+		atomic_store_explicit(&Limit->Count, 0, memory_order_relaxed);
+	if(atomic_fetch_add_explicit(&Limit->Count, 1, memory_order_relaxed) >= LOG_LIMIT_BURST) {
+		atomic_fetch_add_explicit(&Limit->Dropped, 1, memory_order_relaxed);
+		return 0;
+	}
+	return atomic_exchange_explicit(&Limit->Dropped, 0, memory_order_relaxed) + 1;
+}
+
+#define Log_Print(__tag, __info, ...) printf(__tag __info, ##__VA_ARGS__)
+#define Log_Print_Limit(__tag, __info, ...) do { \
+		static LOG_LIMIT __limit; \
+		unsigned __n = Log_Allow(&__limit); \
+		if(__n > 1) \
+			printf(__tag "%u messages suppressed\r\n", __n - 1); \
+		if(__n > 0) \
+			printf(__tag __info, ##__VA_ARGS__); \
+	} while(0)
+// compiled out, the arguments are still type checked and count as used
+#define Log_None(__info, ...) do { if(0) printf(__info, ##__VA_ARGS__); } while(0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+	#define Log_Error(__info, ...)			Log_Print("Error: ", __info, ##__VA_ARGS__)
+	#define Log_Error_Limit(__info, ...)	Log_Print_Limit("Error: ", __info, ##__VA_ARGS__)
+#else
+	#define Log_Error(__info, ...)			Log_None(__info, ##__VA_ARGS__)
+	#define Log_Error_Limit(__info, ...)	Log_None(__info, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+	#define Log_Warn(__info, ...)			Log_Print("Warn: ", __info, ##__VA_ARGS__)
+	#define Log_Warn_Limit(__info, ...)		Log_Print_Limit("Warn: ", __info, ##__VA_ARGS__)
+#else
+	#define Log_Warn(__info, ...)			Log_None(__info, ##__VA_ARGS__)
+	#define Log_Warn_Limit(__info, ...)		Log_None(__info, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+	#define Log_Info(__info, ...)			Log_Print("", __info, ##__VA_ARGS__)
+#else
+	#define Log_Info(__info, ...)			Log_None(__info, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+	#define Log_Debug(__info, ...)			Log_Print("Debug: ", __info, ##__VA_ARGS__)
+#else
+	#define Log_Debug(__info, ...)			Log_None(__info, ##__VA_ARGS__)
+#endif
+
 #endif
 
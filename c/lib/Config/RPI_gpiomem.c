@@ -0,0 +1,134 @@
+/*****************************************************************************
+* | File        :   RPI_gpiomem.c
+* | Author      :   Waveshare team
+* | Function    :   Drive Raspberry Pi 5 (RP1) GPIO registers
+* | Info        :   mmap /dev/gpiomem0, one load or store per access
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :   Basic version
+*
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "RPI_gpiomem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+static volatile uint32_t *RP1_Base = NULL;
+
+#define RP1_REG(Off)    RP1_Base[(Off) / 4]
+
+/******************************************************************************
+function:   Map the RP1 GPIO bank 0 registers
+parameter:
+Info:
+    /dev/gpiomem0 only exists on the Pi 5, and needs no root for the gpio
+    group. Pin numbers are bank 0 lines, i.e. BCM numbers, no sysfs offset.
+    Return 0 success, -1 failed
+******************************************************************************/
+int RP1_GPIO_Begin(void)
+{
+    void *map;
+    int fd;
+
+    if (RP1_Base != NULL) {
+        return 0;
+    }
+    fd = open(RP1_GPIOMEM, O_RDWR | O_SYNC | O_CLOEXEC);
+    if (fd < 0) {
+        RP1_GPIO_Debug("open %s failed\r\n", RP1_GPIOMEM);
+        return -1;
+    }
+    map = mmap(NULL, RP1_GPIOMEM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);      // the mapping stays valid
+    if (map == MAP_FAILED) {
+        RP1_GPIO_Debug("mmap %s failed\r\n", RP1_GPIOMEM);
+        return -1;
+    }
+    RP1_Base = (volatile uint32_t *)map;
+    return 0;
+}
+
+/******************************************************************************
+function:   Unmap the registers
+parameter:
+Info:   Pins keep their last function and level
+******************************************************************************/
+void RP1_GPIO_End(void)
+{
+    if (RP1_Base != NULL) {
+        munmap((void *)RP1_Base, RP1_GPIOMEM_SIZE);
+        RP1_Base = NULL;
+    }
+}
+
+/******************************************************************************
+function:   Hand a pin to the RIO block as input or output
+parameter:
+    Pin  : bank 0 line
+    Mode : RP1_GPIO_IN or RP1_GPIO_OUT
+Info:
+    Return 0 success, -1 pin out of range or not mapped
+******************************************************************************/
+int RP1_GPIO_Mode(int Pin, int Mode)
+{
+    uint32_t ctrl, pad;
+
+    if (RP1_Base == NULL || Pin < 0 || Pin >= RP1_GPIO_NPIN) {
+        RP1_GPIO_Debug("Pin%d not available\r\n", Pin);
+        return -1;
+    }
+    pad = RP1_REG(RP1_PADS_BANK0 + 4 + Pin * 4);
+    RP1_REG(RP1_PADS_BANK0 + 4 + Pin * 4) = (pad & ~RP1_PAD_OD) | RP1_PAD_IE;
+
+    ctrl = RP1_REG(RP1_IO_BANK0 + Pin * 8 + 4);
+    RP1_REG(RP1_IO_BANK0 + Pin * 8 + 4) = (ctrl & ~0x1fu) | RP1_FSEL_SYS_RIO;
+
+    if (Mode == RP1_GPIO_OUT) {
+        RP1_REG(RP1_SYS_RIO0 + RP1_ALIAS_SET + RP1_RIO_OE) = 1u << Pin;
+    } else {
+        RP1_REG(RP1_SYS_RIO0 + RP1_ALIAS_CLR + RP1_RIO_OE) = 1u << Pin;
+    }
+    return 0;
+}
+
+/******************************************************************************
+function:   Drive an output pin
+parameter:
+Info:   One store to the SET or CLR alias, no read-modify-write
+******************************************************************************/
+void RP1_GPIO_Write(int Pin, int Value)
+{
+    RP1_REG(RP1_SYS_RIO0 + (Value ? RP1_ALIAS_SET : RP1_ALIAS_CLR) + RP1_RIO_OUT) = 1u << Pin;
+}
+
+/******************************************************************************
+function:   Read a pin level
+parameter:
+Info:   One load of SYNC_IN, return 0/1
+******************************************************************************/
+int RP1_GPIO_Read(int Pin)
+{
+    return (RP1_REG(RP1_SYS_RIO0 + RP1_RIO_IN) >> Pin) & 1;
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+* | File        :   RPI_gpiomem.h
+* | Author      :   Waveshare team
+* | Function    :   Drive Raspberry Pi 5 (RP1) GPIO registers
+* | Info        :   mmap /dev/gpiomem0, one load or store per access
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :   Basic version
+*
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef __RPI_GPIOMEM_
+#define __RPI_GPIOMEM_
+
+#include <stdint.h>
+
+#define RP1_GPIOMEM         "/dev/gpiomem0"
+#define RP1_GPIOMEM_SIZE    0x30000
+
+/* block offsets inside the mapping */
+#define RP1_IO_BANK0        0x00000     // STATUS, CTRL per pin, 8 bytes apart
+#define RP1_SYS_RIO0        0x10000     // OUT, OE, SYNC_IN
+#define RP1_PADS_BANK0      0x20000     // VOLTAGE_SELECT, then one pad per pin
+
+/* atomic register aliases */
+#define RP1_ALIAS_SET       0x2000
+#define RP1_ALIAS_CLR       0x3000
+
+#define RP1_RIO_OUT         0x00
+#define RP1_RIO_OE          0x04
+#define RP1_RIO_IN          0x08
+
+#define RP1_FSEL_SYS_RIO    5
+#define RP1_PAD_OD          0x80        // output disable
+#define RP1_PAD_IE          0x40        // input enable
+
+#define RP1_GPIO_NPIN       28          // bank 0, the 40-pin header
+
+#define RP1_GPIO_IN         0
+#define RP1_GPIO_OUT        1
+
+#define RP1_GPIO_DEBUG 0
+#if RP1_GPIO_DEBUG
+	#define RP1_GPIO_Debug(__info,...) printf("Debug: " __info,##__VA_ARGS__)
+#else
+	#define RP1_GPIO_Debug(__info,...)
+#endif
+
+int RP1_GPIO_Begin(void);
+void RP1_GPIO_End(void);
+int RP1_GPIO_Mode(int Pin, int Mode);
+void RP1_GPIO_Write(int Pin, int Value);
+int RP1_GPIO_Read(int Pin);
+
+#endif
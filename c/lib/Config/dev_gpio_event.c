@@ -0,0 +1,246 @@
+/*****************************************************************************
+* | File        :   dev_gpio_event.c
+* | Author      :   Waveshare team
+* | Function    :   GPIO edge events through /dev/gpiochipN
+* | Info        :   Blocks on a falling edge instead of polling the level
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :   Basic version
+*
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#define _GNU_SOURCE     // ppoll()
+#include "dev_gpio_event.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <dirent.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+/******************************************************************************
+function:   Request falling-edge events on a chip line
+parameter:
+    Event : line to fill, released first if it holds one
+    Label : gpiochip label, e.g. "pinctrl-rp1", "pinctrl-bcm2711"
+    Line  : line offset on that chip
+Info:
+    Return 0 success
+    Return -1 failed (no such chip, line busy, no permission)
+******************************************************************************/
+int DEV_GPIO_EVENT_Begin(GPIO_EVENT *Event, const char *Label, uint32_t Line)
+{
+    struct gpiochip_info info;
+    struct gpioevent_request req;
+    char path[32];
+    int i, fd;
+
+    DEV_GPIO_EVENT_End(Event);
+    for(i = 0; i < GPIO_EVENT_MAXCHIP; i++) {
+        snprintf(path, sizeof(path), "/dev/gpiochip%d", i);
+        fd = open(path, O_RDWR | O_CLOEXEC);
+        if(fd < 0)
+            continue;
+        if(ioctl(fd, GPIO_GET_CHIPINFO_IOCTL, &info) < 0 || strcmp(info.label, Label) != 0 || Line >= info.lines) {
+            close(fd);
+            continue;
+        }
+
+        memset(&req, 0, sizeof(req));
+        req.lineoffset = Line;
+        req.handleflags = GPIOHANDLE_REQUEST_INPUT;
+        req.eventflags = GPIOEVENT_REQUEST_FALLING_EDGE;
+        strncpy(req.consumer_label, GPIO_EVENT_CONSUMER, sizeof(req.consumer_label) - 1);
+        if(ioctl(fd, GPIO_GET_LINEEVENT_IOCTL, &req) < 0) {
+            DEV_GPIO_EVENT_Debug("%s line %u: event request failed\r\n", path, Line);
+            close(fd);
+            return -1;
+        }
+        close(fd);      // the event fd keeps the line
+
+        // stale edges are drained before each wait, so reads must not block
+        fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK);
+        Event->fd = req.fd;
+        Event->line = Line;
+        DEV_GPIO_EVENT_Debug("%s (%s) line %u: falling edge events\r\n", path, Label, Line);
+        return 0;
+    }
+    DEV_GPIO_EVENT_Debug("no gpiochip labelled %s\r\n", Label);
+    return -1;
+}
+
+/******************************************************************************
+function:   Request falling-edge events for a sysfs GPIO number
+parameter:
+    Event : line to fill
+    Pin   : global sysfs number, as used by SYSFS_GPIO_xxx
+Info:
+    Finds the chip whose [base, base + ngpio) range holds Pin.
+    The pin must not be exported through sysfs at the same time.
+******************************************************************************/
+int DEV_GPIO_EVENT_BeginSysfs(GPIO_EVENT *Event, int Pin)
+{
+    char path[300], label[64];
+    struct dirent *ent;
+    int base, ngpio;
+    FILE *fp;
+    DIR *dir;
+
+    dir = opendir("/sys/class/gpio");
+    if(dir == NULL)
+        return -1;
+    while((ent = readdir(dir)) != NULL) {
+        if(strncmp(ent->d_name, "gpiochip", 8) != 0)
+            continue;
+
+        base = ngpio = -1;
+        snprintf(path, sizeof(path), "/sys/class/gpio/%s/base", ent->d_name);
+        if((fp = fopen(path, "r")) != NULL) {
+            if(fscanf(fp, "%d", &base) != 1)
+                base = -1;
+            fclose(fp);
+        }
+        snprintf(path, sizeof(path), "/sys/class/gpio/%s/ngpio", ent->d_name);
+        if((fp = fopen(path, "r")) != NULL) {
+            if(fscanf(fp, "%d", &ngpio) != 1)
+                ngpio = -1;
+            fclose(fp);
+        }
+        if(base < 0 || Pin < base || Pin >= base + ngpio)
+            continue;
+
+        snprintf(path, sizeof(path), "/sys/class/gpio/%s/label", ent->d_name);
+        if((fp = fopen(path, "r")) == NULL)
+            break;
+        if(fgets(label, sizeof(label), fp) == NULL) {
+            fclose(fp);
+            break;
+        }
+        fclose(fp);
+        closedir(dir);
+        label[strcspn(label, "\r\n")] = '\0';
+        return DEV_GPIO_EVENT_Begin(Event, label, Pin - base);
+    }
+    closedir(dir);
+    return -1;
+}
+
+/******************************************************************************
+function:   Release the event line
+parameter:
+Info:
+******************************************************************************/
+void DEV_GPIO_EVENT_End(GPIO_EVENT *Event)
+{
+    if(Event->fd >= 0) {
+        close(Event->fd);
+        Event->fd = -1;
+    }
+}
+
+/******************************************************************************
+function:   Event line state
+parameter:
+Info:   Return 1 when a line is held, 0 otherwise
+******************************************************************************/
+int DEV_GPIO_EVENT_IsOpen(const GPIO_EVENT *Event)
+{
+    return Event->fd >= 0;
+}
+
+/******************************************************************************
+function:   Read the level of the event line
+parameter:
+Info:   Return 0/1, -1 failed
+******************************************************************************/
+int DEV_GPIO_EVENT_Read(GPIO_EVENT *Event)
+{
+    struct gpiohandle_data data;
+    if(ioctl(Event->fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) < 0)
+        return -1;
+    return data.values[0];
+}
+
+/******************************************************************************
+function:   Wait until the line is low
+parameter:
+    Event      : held line
+    Timeout_us : give up after this many microseconds
+Info:
+    Returns at once if the line is already low, otherwise sleeps in the
+    kernel until the next falling edge. A signal does not cut the wait
+    short: ppoll is called again for what is left of Timeout_us.
+    Return 1 line low
+    Return 0 timeout
+    Return -1 failed
+******************************************************************************/
+int DEV_GPIO_EVENT_WaitLow(GPIO_EVENT *Event, uint32_t Timeout_us)
+{
+    struct gpioevent_data ev;
+    struct pollfd pfd;
+    struct timespec ts, now, end;
+    int64_t left_ns;
+    int ret;
+
+    if(DEV_GPIO_EVENT_Read(Event) == 0)
+        return 1;
+
+    // drop edges of conversions nobody waited for, then look again so an
+    // edge between the first read and the drain is not lost
+    while(read(Event->fd, &ev, sizeof(ev)) == sizeof(ev));
+    if(DEV_GPIO_EVENT_Read(Event) == 0)
+        return 1;
+
+    pfd.fd = Event->fd;
+    pfd.events = POLLIN | POLLPRI;
+    pfd.revents = 0;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    end.tv_sec += Timeout_us / 1000000;
+    end.tv_nsec += (Timeout_us % 1000000) * 1000;
+    if(end.tv_nsec >= 1000000000) {
+        end.tv_sec++;
+        end.tv_nsec -= 1000000000;
+    }
+    ts.tv_sec = Timeout_us / 1000000;
+    ts.tv_nsec = (Timeout_us % 1000000) * 1000;
+    while((ret = ppoll(&pfd, 1, &ts, NULL)) < 0) {
+        if(errno != EINTR)
+            return -1;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        left_ns = (int64_t)(end.tv_sec - now.tv_sec) * 1000000000 + (end.tv_nsec - now.tv_nsec);
+        if(left_ns <= 0)
+            return 0;
+        ts.tv_sec = left_ns / 1000000000;
+        ts.tv_nsec = left_ns % 1000000000;
+    }
+    if(ret == 0)
+        return 0;
+    if(read(Event->fd, &ev, sizeof(ev)) != sizeof(ev))
+        return -1;
+    return 1;
+}
@@ -0,0 +1,62 @@
+/*****************************************************************************
+* | File        :   dev_gpio_event.h
+* | Author      :   Waveshare team
+* | Function    :   GPIO edge events through /dev/gpiochipN
+* | Info        :   Blocks on a falling edge instead of polling the level
+*----------------
+* |	This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :   Basic version
+*
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef __DEV_GPIO_EVENT_
+#define __DEV_GPIO_EVENT_
+
+#include <stdint.h>
+
+#define DEV_GPIO_EVENT_DEBUG 0
+#if DEV_GPIO_EVENT_DEBUG
+#define DEV_GPIO_EVENT_Debug(__info,...) printf("Debug: " __info,##__VA_ARGS__)
+#else
+#define DEV_GPIO_EVENT_Debug(__info,...)
+#endif
+
+#define GPIO_EVENT_MAXCHIP  16
+#define GPIO_EVENT_CONSUMER "ads1263-drdy"
+
+/**
+ * Define event line attribute
+**/
+typedef struct GPIOEventStruct {
+    int fd;         // line event fd, -1 when not requested
+    uint32_t line;  // line offset on the chip
+} GPIO_EVENT;
+
+int DEV_GPIO_EVENT_Begin(GPIO_EVENT *Event, const char *Label, uint32_t Line);
+int DEV_GPIO_EVENT_BeginSysfs(GPIO_EVENT *Event, int Pin);
+void DEV_GPIO_EVENT_End(GPIO_EVENT *Event);
+
+int DEV_GPIO_EVENT_IsOpen(const GPIO_EVENT *Event);
+int DEV_GPIO_EVENT_Read(GPIO_EVENT *Event);
+int DEV_GPIO_EVENT_WaitLow(GPIO_EVENT *Event, uint32_t Timeout_us);
+
+#endif
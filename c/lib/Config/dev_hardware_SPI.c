@@ -33,6 +33,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <stdint.h> 
 #include <unistd.h> 
@@ -138,6 +139,49 @@ void DEV_HARDWARE_SPI_end(void)
     }
 }
 
+/******************************************************************************
+function:   Open one more SPI device, independent of hardware_SPI
+parameter:
+    SPI_device : Device name, e.g. /dev/spidev0.1
+    mode       : SPI_MODE0 - SPI_MODE3
+    speed      : clock in Hz
+Info:
+    spidev keeps mode and speed per device node, so each board on its own
+    chip select gets its own fd and needs nothing else.
+    Return the fd, -1 failed
+******************************************************************************/
+int DEV_HARDWARE_SPI_Open(char *SPI_device, SPIMode mode, uint32_t speed)
+{
+    uint8_t spi_mode = mode;
+    int fd;
+
+    if((fd = open(SPI_device, O_RDWR)) < 0) {
+        DEV_HARDWARE_SPI_Debug("Failed to open %s\r\n", SPI_device);
+        return -1;
+    }
+    if(ioctl(fd, SPI_IOC_WR_BITS_PER_WORD, &bits) == -1
+        || ioctl(fd, SPI_IOC_WR_MODE, &spi_mode) == -1
+        || ioctl(fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) == -1) {
+        DEV_HARDWARE_SPI_Debug("can't set up %s\r\n", SPI_device);
+        close(fd);
+        return -1;
+    }
+    DEV_HARDWARE_SPI_Debug("open : %s\r\n", SPI_device);
+    return fd;
+}
+
+/******************************************************************************
+function:   Close a device opened with DEV_HARDWARE_SPI_Open
+parameter:
+Info:
+******************************************************************************/
+void DEV_HARDWARE_SPI_Close(int fd)
+{
+    if(fd >= 0 && close(fd) != 0) {
+        DEV_HARDWARE_SPI_Debug("Failed to close SPI device\r\n");
+    }
+}
+
 /******************************************************************************
 function:   Set SPI speed
 parameter:
@@ -360,3 +404,91 @@ int DEV_HARDWARE_SPI_Transfer(uint8_t *buf, uint32_t len)
     return 1;
 }
 
+/******************************************************************************
+function:   Full-duplex transfer on a device opened with DEV_HARDWARE_SPI_Open
+parameter:
+    fd  : device
+    buf : bytes to send, overwritten with the bytes received
+    len : frame length
+Info:
+    Speed and mode are the device's own, as set when it was opened.
+    Return 1 success, -1 failed
+******************************************************************************/
+int DEV_HARDWARE_SPI_TransferFd(int fd, uint8_t *buf, uint32_t len)
+{
+    struct spi_ioc_transfer xfer;
+
+    memset(&xfer, 0, sizeof(xfer));
+    xfer.tx_buf = (unsigned long)buf;
+    xfer.rx_buf = (unsigned long)buf;
+    xfer.len = len;
+    xfer.bits_per_word = bits;
+    if(ioctl(fd, SPI_IOC_MESSAGE(1), &xfer) < 1) {
+        DEV_HARDWARE_SPI_Debug("can't send spi message\r\n");
+        return -1;
+    }
+    return 1;
+}
+
+/******************************************************************************
+function:   Start an empty transfer chain
+parameter:
+Info:
+******************************************************************************/
+void DEV_HARDWARE_SPI_ChainInit(HARDWARE_SPI_CHAIN *Chain)
+{
+    Chain->Number = 0;
+}
+
+/******************************************************************************
+function:   Queue one full-duplex transfer
+parameter:
+    buf       : bytes to send, overwritten with the bytes received
+    len       : frame length
+    cs_change : 1 deassert the kernel's CS after this transfer
+Info:
+    Nothing goes out until DEV_HARDWARE_SPI_ChainRun; buf has to stay
+    valid until then. Without cs_change the kernel holds CS across the
+    whole chain.
+    Return 1 success, -1 chain full
+******************************************************************************/
+int DEV_HARDWARE_SPI_ChainAdd(HARDWARE_SPI_CHAIN *Chain, uint8_t *buf, uint32_t len, uint8_t cs_change)
+{
+    struct spi_ioc_transfer *xfer;
+
+    if(Chain->Number >= DEV_HARDWARE_SPI_MAXCHAIN) {
+        DEV_HARDWARE_SPI_Debug("spi chain full\r\n");
+        return -1;
+    }
+    xfer = &Chain->Xfer[Chain->Number++];
+    memset(xfer, 0, sizeof(*xfer));
+    xfer->tx_buf = (unsigned long)buf;
+    xfer->rx_buf = (unsigned long)buf;
+    xfer->len = len;
+    xfer->bits_per_word = bits;
+    xfer->cs_change = cs_change;
+    return 1;
+}
+
+/******************************************************************************
+function:   Send every queued transfer in a single ioctl
+parameter:
+    fd    : device opened with DEV_HARDWARE_SPI_Open
+    Chain : queued transfers, emptied afterwards
+Info:
+    The kernel runs the transfers back to back as one spi_message.
+    Return 1 success, -1 failed
+******************************************************************************/
+int DEV_HARDWARE_SPI_ChainRun(int fd, HARDWARE_SPI_CHAIN *Chain)
+{
+    uint32_t n = Chain->Number;
+
+    Chain->Number = 0;
+    if(n == 0)
+        return 1;
+    if(ioctl(fd, SPI_IOC_MESSAGE(n), Chain->Xfer) < 1) {
+        DEV_HARDWARE_SPI_Debug("can't send spi message\r\n");
+        return -1;
+    }
+    return 1;
+}
@@ -32,6 +32,7 @@
 #define __DEV_HARDWARE_SPI_
 
 #include <stdint.h>
+#include <linux/spi/spidev.h>
 
 #define DEV_HARDWARE_SPI_DEBUG 0
 #if DEV_HARDWARE_SPI_DEBUG
@@ -40,8 +41,10 @@
 #define DEV_HARDWARE_SPI_Debug(__info,...)
 #endif
 
+#ifndef SPI_CPHA        // also in linux/spi/spidev.h
 #define SPI_CPHA        0x01
 #define SPI_CPOL        0x02
+#endif
 #define SPI_MODE_0      (0|0)
 #define SPI_MODE_1      (0|SPI_CPHA)
 #define SPI_MODE_2      (SPI_CPOL|0)
@@ -97,6 +100,16 @@ typedef struct SPIStruct {
     int fd; //
 } HARDWARE_SPI;
 
+/**
+ * Transfers queued for one SPI_IOC_MESSAGE(N) ioctl
+**/
+#define DEV_HARDWARE_SPI_MAXCHAIN   8
+
+typedef struct {
+    struct spi_ioc_transfer Xfer[DEV_HARDWARE_SPI_MAXCHAIN];
+    uint32_t Number;
+} HARDWARE_SPI_CHAIN;
+
 
 
 
@@ -104,6 +117,14 @@ void DEV_HARDWARE_SPI_begin(char *SPI_device);
 void DEV_HARDWARE_SPI_beginSet(char *SPI_device, SPIMode mode, uint32_t speed);
 void DEV_HARDWARE_SPI_end(void);
 
+int DEV_HARDWARE_SPI_Open(char *SPI_device, SPIMode mode, uint32_t speed);
+void DEV_HARDWARE_SPI_Close(int fd);
+int DEV_HARDWARE_SPI_TransferFd(int fd, uint8_t *buf, uint32_t len);
+
+void DEV_HARDWARE_SPI_ChainInit(HARDWARE_SPI_CHAIN *Chain);
+int DEV_HARDWARE_SPI_ChainAdd(HARDWARE_SPI_CHAIN *Chain, uint8_t *buf, uint32_t len, uint8_t cs_change);
+int DEV_HARDWARE_SPI_ChainRun(int fd, HARDWARE_SPI_CHAIN *Chain);
+
 int DEV_HARDWARE_SPI_setSpeed(uint32_t speed);
 
 uint8_t DEV_HARDWARE_SPI_TransferByte(uint8_t buf);
@@ -37,6 +37,43 @@
 #include <string.h>
 #include <unistd.h>
 
+/* value fd + 1 per pin, 0 = not open; opened once, then pread/pwrite */
+static int SYSFS_GPIO_fd[SYSFS_GPIO_MAXPIN];
+
+static int SYSFS_GPIO_Open(int Pin)
+{
+    char path[DIR_MAXSIZ];
+    int fd;
+
+    if (Pin < 0 || Pin >= SYSFS_GPIO_MAXPIN) {
+        SYSFS_GPIO_Debug( "Pin%d out of range\n", Pin);
+        return -1;
+    }
+    if (SYSFS_GPIO_fd[Pin] > 0) {
+        return SYSFS_GPIO_fd[Pin] - 1;
+    }
+
+    snprintf(path, DIR_MAXSIZ, "/sys/class/gpio/gpio%d/value", Pin);
+    fd = open(path, O_RDWR);
+    if (fd < 0) {
+        fd = open(path, O_RDONLY);
+    }
+    if (fd < 0) {
+        SYSFS_GPIO_Debug( "Open value failed: Pin%d\n", Pin);
+        return -1;
+    }
+    SYSFS_GPIO_fd[Pin] = fd + 1;
+    return fd;
+}
+
+static void SYSFS_GPIO_Close(int Pin)
+{
+    if (Pin >= 0 && Pin < SYSFS_GPIO_MAXPIN && SYSFS_GPIO_fd[Pin] > 0) {
+        close(SYSFS_GPIO_fd[Pin] - 1);
+        SYSFS_GPIO_fd[Pin] = 0;
+    }
+}
+
 int SYSFS_GPIO_Export(int Pin)
 {
     char buffer[NUM_MAXBUF];
@@ -64,6 +101,7 @@ int SYSFS_GPIO_Unexport(int Pin)
     int len;
     int fd;
 
+    SYSFS_GPIO_Close(Pin);
     fd = open("/sys/class/gpio/unexport", O_WRONLY);
     if (fd < 0) {
         SYSFS_GPIO_Debug( "unexport Failed: Pin%d\n", Pin);
@@ -104,49 +142,44 @@ int SYSFS_GPIO_Direction(int Pin, int Dir)
     }
     
     close(fd);
+    SYSFS_GPIO_Open(Pin);
     return 0;
 }
 
 int SYSFS_GPIO_Read(int Pin)
 {
-    char path[DIR_MAXSIZ];
     char value_str[3];
     int fd;
     
-    snprintf(path, DIR_MAXSIZ, "/sys/class/gpio/gpio%d/value", Pin);
-    fd = open(path, O_RDONLY);
+    fd = SYSFS_GPIO_Open(Pin);
     if (fd < 0) {
         SYSFS_GPIO_Debug( "Read failed Pin%d\n", Pin);
         return -1;
     }
 
-    if (read(fd, value_str, 3) < 0) {
+    if (pread(fd, value_str, 3, 0) < 1) {
         SYSFS_GPIO_Debug( "failed to read value!\n");
         return -1;
     }
 
-    close(fd);
-    return(atoi(value_str));
+    return(value_str[0] - '0');
 }
 
 int SYSFS_GPIO_Write(int Pin, int value)
 {
     const char s_values_str[] = "01";
-    char path[DIR_MAXSIZ];
     int fd;
     
-    snprintf(path, DIR_MAXSIZ, "/sys/class/gpio/gpio%d/value", Pin);
-    fd = open(path, O_WRONLY);
+    fd = SYSFS_GPIO_Open(Pin);
     if (fd < 0) {
         SYSFS_GPIO_Debug( "Write failed : Pin%d,value = %d\n", Pin, value);
         return -1;
     }
 
-    if (write(fd, &s_values_str[value == LOW ? 0 : 1], 1) < 0) {
+    if (pwrite(fd, &s_values_str[value == LOW ? 0 : 1], 1, 0) < 0) {
         SYSFS_GPIO_Debug( "failed to write value!\n");
         return -1;
     }
     
-    close(fd);
     return 0;
 }
@@ -41,6 +41,7 @@
 
 #define NUM_MAXBUF  4
 #define DIR_MAXSIZ  60
+#define SYSFS_GPIO_MAXPIN   1024    // covers the Pi 5 offset (571 + 54)
 
 #define SYSFS_GPIO_DEBUG 1
 #if SYSFS_GPIO_DEBUG 
@@ -84,7 +84,7 @@ typedef enum {
 /**
  * Define SPI attribute
 **/
-typedef struct SPIStruct {
+typedef struct SoftwareSPIStruct {
     //GPIO
     uint16_t SCLK_PIN;
     uint16_t MOSI_PIN;
@@ -28,22 +28,265 @@
 #
 ******************************************************************************/
 #include "ADS1263.h"
+#include "ADS1263_Scan.h"
+#include <time.h>
 
-UBYTE ScanMode = 0;
+/* RDATAx command + status + 4 bytes data/pad + CRC */
+#define ADS1263_DATA_FRAME  7
+/* longest first conversion: 2.5 SPS with sinc4 settling plus the 8.8 ms delay */
+#define ADS1263_DRDY_TIMEOUT_US 3000000
+/* RDATA frames without the new-data bit before a readout gives up; CS and the bus stay held meanwhile */
+#define ADS1263_READ_RETRY      4
+
+/* fast reset, tCLK = 1 / 7.3728 MHz: RESET low >= 4 tCLK, 2^16 tCLK until the first command */
+#define ADS1263_RESET_PULSE_US  10
+#define ADS1263_RESET_WAIT_US   9000
+
+/* START1 to DRDY high, a few tCLK; before it an old result can still look ready */
+#define ADS1263_START_US        10
+
+/* never trusted from the shadow: ID is read-only, GPIODAT follows the pins */
+#define ADS1263_SHADOW_VOLATILE ((1UL << REG_ID) | (1UL << REG_GPIODAT))
+
+/* power-on/reset values, see ADS1263_REG */
+static const UBYTE ADS1263_ResetValue[ADS1263_REG_NUM] = {
+    0x00, 0x11, 0x05, 0x00, 0x80, 0x04, 0x01,       // ID .. INPMUX
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x40,             // OFCAL0 .. FSCAL2
+    0xBB, 0x00, 0x00, 0x00, 0x00,                   // IDACMUX .. TDACN
+    0x00, 0x00, 0x00,                               // GPIOCON .. GPIODAT
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x40,             // ADC2CFG .. ADC2FSC1
+};
+
+/******************************************************************************
+function:   Set up a device handle
+parameter:
+    Dev  : handle to fill
+    Port : board it drives, DEV_Port0 or one set up with DEV_Port_Init
+Info:
+    Single-ended mode, nothing known about the registers yet. One handle
+    per board; handles on different ports are independent.
+******************************************************************************/
+void ADS1263_Device_Init(ADS1263_DEVICE *Dev, DEV_PORT *Port)
+{
+    memset(Dev, 0, sizeof(*Dev));
+    Dev->Port = Port;
+    Dev->PlanMode = 0xff;
+    Dev->CrcMode = ADS1263_CRC_CHECKSUM;
+}
+
+/******************************************************************************
+function:   Set the shadow to the values the chip holds after a reset
+parameter:
+Info:
+******************************************************************************/
+static void ADS1263_ShadowReset(ADS1263_DEVICE *Dev)
+{
+    memcpy(Dev->Shadow, ADS1263_ResetValue, sizeof(Dev->Shadow));
+    Dev->CrcMode = ADS1263_ResetValue[REG_INTERFACE] & 0x03;
+    Dev->ShadowValid = ((1UL << ADS1263_REG_NUM) - 1) & ~ADS1263_SHADOW_VOLATILE;
+}
+
+/******************************************************************************
+function:   Forget cached register values
+parameter:
+    First : first register
+    Count : number of registers, 0 forgets all of them
+Info:
+    The next write to these registers always goes out on the bus
+******************************************************************************/
+void ADS1263_ShadowInvalidate(ADS1263_DEVICE *Dev, UBYTE First, UBYTE Count)
+{
+    if(Count == 0) {
+        Dev->ShadowValid = 0;
+        return;
+    }
+    while(Count-- && First < ADS1263_REG_NUM) {
+        Dev->ShadowValid &= ~(1UL << First++);
+    }
+}
+
+/******************************************************************************
+function:   Mux read-back verification
+parameter:
+    Period : 0 never read back, 1 after every channel select,
+             N every Nth channel select
+Info:
+    A mismatch is reported and the shadow takes the value read back,
+    so the next select writes the register again.
+******************************************************************************/
+void ADS1263_SetVerify(ADS1263_DEVICE *Dev, UDOUBLE Period)
+{
+    Dev->VerifyPeriod = Period;
+    Dev->VerifyCount = 0;
+}
+
+/******************************************************************************
+function:   Reset timing used by the ADS1263_init_xxx functions
+parameter:
+    Enable : 0 the 3 x 300 ms reset the demo has always used,
+             1 the data sheet minimum, about 9 ms
+Info:
+    Fast start assumes the supplies are up, as they are when a service
+    restarts on a running board. If the chip ID cannot be read after a
+    fast reset, the slow one is tried before giving up.
+******************************************************************************/
+void ADS1263_SetFastStart(ADS1263_DEVICE *Dev, UBYTE Enable)
+{
+    Dev->FastStart = Enable;
+}
+
+/******************************************************************************
+function:   Read the error counters
+parameter:
+    Err   : receives the counts
+    Clear : 1 start counting from 0 again
+Info:
+    Safe while another thread drives the device, e.g. an ADS1263_STREAM.
+    The errors themselves are logged rate limited, see Log_Warn_Limit.
+******************************************************************************/
+void ADS1263_GetErrors(ADS1263_DEVICE *Dev, ADS1263_ERRORS *Err, UBYTE Clear)
+{
+    if(Clear) {
+        Err->Crc = atomic_exchange_explicit(&Dev->ErrCrc, 0, memory_order_relaxed);
+        Err->Timeout = atomic_exchange_explicit(&Dev->ErrTimeout, 0, memory_order_relaxed);
+        Err->Verify = atomic_exchange_explicit(&Dev->ErrVerify, 0, memory_order_relaxed);
+        Err->Config = atomic_exchange_explicit(&Dev->ErrConfig, 0, memory_order_relaxed);
+    } else {
+        Err->Crc = atomic_load_explicit(&Dev->ErrCrc, memory_order_relaxed);
+        Err->Timeout = atomic_load_explicit(&Dev->ErrTimeout, memory_order_relaxed);
+        Err->Verify = atomic_load_explicit(&Dev->ErrVerify, memory_order_relaxed);
+        Err->Config = atomic_load_explicit(&Dev->ErrConfig, memory_order_relaxed);
+    }
+}
+
+/******************************************************************************
+function:   Attach hot-path statistics
+parameter:
+    Stats : block set up with ADS1263_Stats_Init, NULL stops recording
+Info:
+    Set while nothing drives the device. From then on the driver times
+    every DRDY wait, mux write, readout and checksum and counts retries,
+    CRC errors and timeouts into it; take copies from any thread with
+    ADS1263_Stats_Snapshot. Detached, each stage costs one test of the
+    pointer; built with STATS=0 not even that.
+******************************************************************************/
+void ADS1263_SetStats(ADS1263_DEVICE *Dev, ADS1263_STATS *Stats)
+{
+    Dev->Stats = Stats;
+}
+
+/******************************************************************************
+function:   Select the data frame check
+parameter:
+    Mode : ADS1263_CRC_OFF, ADS1263_CRC_CHECKSUM (reset default) or ADS1263_CRC_CRC8
+Info:
+    Writes the CRC bits of REG_INTERFACE and reads them back. Call after
+    ADS1263_init_xxx, a reset goes back to the checksum.
+    Return 0 success, 1 bad mode or the register did not read back
+******************************************************************************/
+UBYTE ADS1263_SetCrcMode(ADS1263_DEVICE *Dev, ADS1263_CRC_MODE Mode)
+{
+    UBYTE Value;
+
+    if(Mode > ADS1263_CRC_CRC8) {
+        return 1;
+    }
+    Value = (ADS1263_GetReg(Dev, REG_INTERFACE) & ~0x03) | Mode;
+    ADS1263_WriteReg(Dev, REG_INTERFACE, Value);
+    if(ADS1263_Read_data(Dev, REG_INTERFACE) != Value) {
+        atomic_fetch_add_explicit(&Dev->ErrConfig, 1, memory_order_relaxed);
+        Log_Error("REG_INTERFACE unsuccess \r\n");
+        return 1;
+    }
+    Dev->CrcMode = Mode;
+    return 0;
+}
+
+/******************************************************************************
+function:   Leave the data frame check to the consumer
+parameter:
+    Enable : 1 readouts no longer check or flag ADS1263_SAMPLE_CRC_ERR,
+             the samples are verified in blocks with ADS1263_CheckBlock
+Info:
+    For streams: the acquisition thread stays short and bad samples end
+    up in a bitmap beside the batch instead of the log.
+******************************************************************************/
+void ADS1263_SetCrcDefer(ADS1263_DEVICE *Dev, UBYTE Enable)
+{
+    Dev->CrcDefer = Enable;
+}
+
+/* stage timing, a no-op unless a statistics block is attached */
+static inline uint64_t ADS1263_Stats_Begin(ADS1263_DEVICE *Dev)
+{
+#if ADS1263_USE_STATS
+    if(Dev->Stats != NULL)
+        return ADS1263_Stats_Now();
+#endif
+    return 0;
+}
+
+static inline void ADS1263_Stats_End(ADS1263_DEVICE *Dev, ADS1263_STAGE Stage, uint64_t Start)
+{
+#if ADS1263_USE_STATS
+    if(Dev->Stats != NULL)
+        ADS1263_Stats_Record(Dev->Stats, Stage, Start);
+#endif
+}
+
+static inline void ADS1263_Stats_Event(ADS1263_DEVICE *Dev, ADS1263_COUNTER Counter)
+{
+#if ADS1263_USE_STATS
+    if(Dev->Stats != NULL)
+        ADS1263_Stats_Count(Dev->Stats, Counter);
+#endif
+}
 
 /******************************************************************************
 function:   Module reset
 parameter:
 Info:
 ******************************************************************************/
-static void ADS1263_reset(void)
+static void ADS1263_reset(ADS1263_DEVICE *Dev)
 {
-    DEV_Digital_Write(DEV_RST_PIN, 1);
-    DEV_Delay_ms(300);
-    DEV_Digital_Write(DEV_RST_PIN, 0);
-    DEV_Delay_ms(300);
-    DEV_Digital_Write(DEV_RST_PIN, 1);
-    DEV_Delay_ms(300);
+    if(Dev->FastStart) {
+        DEV_Digital_Write(Dev->Port->RST_PIN, 0);
+        DEV_Delay_us(ADS1263_RESET_PULSE_US);
+        DEV_Digital_Write(Dev->Port->RST_PIN, 1);
+        DEV_Delay_us(ADS1263_RESET_WAIT_US);
+    } else {
+        DEV_Digital_Write(Dev->Port->RST_PIN, 1);
+        DEV_Delay_ms(300);
+        DEV_Digital_Write(Dev->Port->RST_PIN, 0);
+        DEV_Delay_ms(300);
+        DEV_Digital_Write(Dev->Port->RST_PIN, 1);
+        DEV_Delay_ms(300);
+    }
+    ADS1263_ShadowReset(Dev);
+}
+
+/******************************************************************************
+function:   Chip select
+parameter: 
+Info:
+    The port's bus lock is held while CS is low, so devices on other
+    threads never clock the shared lines while this one listens.
+    With DEV_CS_HARDWARE the kernel frames CS around each transfer, but
+    the lock is still taken: a GPIO-CS board on the same bus may hold
+    its CS low across several transfers.
+******************************************************************************/
+static void ADS1263_Select(ADS1263_DEVICE *Dev)
+{
+    DEV_Port_Lock(Dev->Port);
+    if(Dev->Port->CS_PIN != DEV_CS_HARDWARE)
+        DEV_Digital_Write(Dev->Port->CS_PIN, 0);
+}
+
+static void ADS1263_Deselect(ADS1263_DEVICE *Dev)
+{
+    if(Dev->Port->CS_PIN != DEV_CS_HARDWARE)
+        DEV_Digital_Write(Dev->Port->CS_PIN, 1);
+    DEV_Port_Unlock(Dev->Port);
 }
 
 /******************************************************************************
@@ -52,11 +295,34 @@ parameter:
         Cmd: command
 Info:
 ******************************************************************************/
-static void ADS1263_WriteCmd(UBYTE Cmd)
+void ADS1263_WriteCmd(ADS1263_DEVICE *Dev, UBYTE Cmd)
 {
-    DEV_Digital_Write(DEV_CS_PIN, 0);
-    DEV_SPI_WriteByte(Cmd);
-    DEV_Digital_Write(DEV_CS_PIN, 1);
+    UBYTE buf = Cmd;
+    ADS1263_Select(Dev);
+    DEV_Port_Transfer(Dev->Port, &buf, 1);
+    ADS1263_Deselect(Dev);
+
+    // commands that change registers behind the shadow's back
+    switch(Cmd) {
+    case CMD_RESET:
+    case CMD_RESET | 1:
+        ADS1263_ShadowReset(Dev);
+        break;
+    case CMD_SYOCAL1:
+    case CMD_SFOCAL1:
+        ADS1263_ShadowInvalidate(Dev, REG_OFCAL0, 3);
+        break;
+    case CMD_SYGCAL1:
+        ADS1263_ShadowInvalidate(Dev, REG_FSCAL0, 3);
+        break;
+    case CMD_SYOCAL2:
+    case CMD_SFOCAL2:
+        ADS1263_ShadowInvalidate(Dev, REG_ADC2OFC0, 2);
+        break;
+    case CMD_SYGCAL2:
+        ADS1263_ShadowInvalidate(Dev, REG_ADC2FSC0, 2);
+        break;
+    }
 }
 
 /******************************************************************************
@@ -65,14 +331,21 @@ parameter:
         Reg : Target register
         data: Written data
 Info:
+    Skipped when the shadow says the register already holds data
 ******************************************************************************/
-static void ADS1263_WriteReg(UBYTE Reg, UBYTE data)
+void ADS1263_WriteReg(ADS1263_DEVICE *Dev, UBYTE Reg, UBYTE data)
 {
-    DEV_Digital_Write(DEV_CS_PIN, 0);
-    DEV_SPI_WriteByte(CMD_WREG | Reg);
-    DEV_SPI_WriteByte(0x00);
-    DEV_SPI_WriteByte(data);
-    DEV_Digital_Write(DEV_CS_PIN, 1);
+    UBYTE buf[3] = {CMD_WREG | Reg, 0x00, data};
+    if(Reg < ADS1263_REG_NUM) {
+        if((Dev->ShadowValid & (1UL << Reg)) && Dev->Shadow[Reg] == data) {
+            return;
+        }
+        Dev->Shadow[Reg] = data;
+        Dev->ShadowValid |= (1UL << Reg) & ~ADS1263_SHADOW_VOLATILE;
+    }
+    ADS1263_Select(Dev);
+    DEV_Port_Transfer(Dev->Port, buf, 3);
+    ADS1263_Deselect(Dev);
 }
 
 /******************************************************************************
@@ -80,60 +353,254 @@ function:   Read a data from the destination register
 parameter: 
         Reg : Target register
 Info:
+    Always reads the chip and refreshes the shadow.
     Return the read data
 ******************************************************************************/
-static UBYTE ADS1263_Read_data(UBYTE Reg)
+UBYTE ADS1263_Read_data(ADS1263_DEVICE *Dev, UBYTE Reg)
+{
+    UBYTE buf[3] = {CMD_RREG | Reg, 0x00, 0x00};
+    ADS1263_Select(Dev);
+    DEV_Port_Transfer(Dev->Port, buf, 3);
+    ADS1263_Deselect(Dev);
+    if(Reg < ADS1263_REG_NUM) {
+        Dev->Shadow[Reg] = buf[2];
+        Dev->ShadowValid |= (1UL << Reg) & ~ADS1263_SHADOW_VOLATILE;
+    }
+    return buf[2];
+}
+
+/******************************************************************************
+function:   Read consecutive registers in one RREG
+parameter: 
+        First : first register, see ADS1263_REG
+        Count : number of registers, First + Count <= ADS1263_REG_NUM
+        Data  : receives Count values
+Info:
+    One chip-select window whatever the count, e.g. OFCAL0 to FSCAL2 for
+    a calibration snapshot. Always reads the chip and refreshes the shadow,
+    so call it from the thread that drives the device.
+    Return 0 success, 1 bad range
+******************************************************************************/
+UBYTE ADS1263_ReadRegs(ADS1263_DEVICE *Dev, UBYTE First, UBYTE Count, UBYTE *Data)
 {
-    UBYTE temp = 0;
-    DEV_Digital_Write(DEV_CS_PIN, 0);
-    DEV_SPI_WriteByte(CMD_RREG | Reg);
-    DEV_SPI_WriteByte(0x00);
-    // DEV_Delay_ms(1);
-    temp = DEV_SPI_ReadByte();
-    DEV_Digital_Write(DEV_CS_PIN, 1);
-    return temp;
+    UBYTE buf[ADS1263_REG_NUM + 2], i;
+    if(Count == 0 || First >= ADS1263_REG_NUM || Count > ADS1263_REG_NUM - First) {
+        return 1;
+    }
+    memset(buf, 0, Count + 2);
+    buf[0] = CMD_RREG | First;
+    buf[1] = CMD_RREG2 | (Count - 1);
+    ADS1263_Select(Dev);
+    DEV_Port_Transfer(Dev->Port, buf, Count + 2);
+    ADS1263_Deselect(Dev);
+    for(i = 0; i < Count; i++) {
+        Data[i] = buf[i + 2];
+        Dev->Shadow[First + i] = buf[i + 2];
+        Dev->ShadowValid |= (1UL << (First + i)) & ~ADS1263_SHADOW_VOLATILE;
+    }
+    return 0;
 }
 
+/******************************************************************************
+function:   Read the whole register map in one RREG
+parameter: 
+        Data : receives ADS1263_REG_NUM values, indexed by ADS1263_REG
+Info:
+******************************************************************************/
+void ADS1263_ReadAllRegs(ADS1263_DEVICE *Dev, UBYTE *Data)
+{
+    ADS1263_ReadRegs(Dev, REG_ID, ADS1263_REG_NUM, Data);
+}
+
+/******************************************************************************
+function:   Register value, from the shadow when it is known
+parameter: 
+        Reg : Target register
+Info:
+    Only touches the bus for registers the shadow does not hold
+******************************************************************************/
+UBYTE ADS1263_GetReg(ADS1263_DEVICE *Dev, UBYTE Reg)
+{
+    if(Reg < ADS1263_REG_NUM && (Dev->ShadowValid & (1UL << Reg))) {
+        return Dev->Shadow[Reg];
+    }
+    return ADS1263_Read_data(Dev, Reg);
+}
+
+/******************************************************************************
+function:   Periodic read-back of a mux register
+parameter: 
+        Reg : REG_INPMUX or REG_ADC2MUX
+        Who : caller name for the error message
+Info:
+    See ADS1263_SetVerify
+******************************************************************************/
+static void ADS1263_VerifyReg(ADS1263_DEVICE *Dev, UBYTE Reg, const char *Who)
+{
+    UBYTE expect;
+    if(Dev->VerifyPeriod == 0 || ++Dev->VerifyCount < Dev->VerifyPeriod) {
+        return;
+    }
+    Dev->VerifyCount = 0;
+    expect = Dev->Shadow[Reg];
+    if(ADS1263_Read_data(Dev, Reg) != expect) {
+        atomic_fetch_add_explicit(&Dev->ErrVerify, 1, memory_order_relaxed);
+        Log_Warn_Limit("%s unsuccess \r\n", Who);
+    }
+}
+
+/******************************************************************************
+function:   Take the data bytes of a WREG frame into the shadow
+parameter: 
+        Frame : CMD_WREG | first register, count - 1, data bytes
+        Len   : frame length
+Info:
+    Return 1 if the frame covers INPMUX, for ADS1263_SetVerify
+******************************************************************************/
+static UBYTE ADS1263_ShadowFrame(ADS1263_DEVICE *Dev, const UBYTE *Frame, UBYTE Len)
+{
+    UBYTE Reg = Frame[0] & 0x1f, i;
+    for(i = 2; i < Len && Reg < ADS1263_REG_NUM; i++, Reg++) {
+        Dev->Shadow[Reg] = Frame[i];
+        Dev->ShadowValid |= (1UL << Reg) & ~ADS1263_SHADOW_VOLATILE;
+    }
+    return (Frame[0] & 0x1f) <= REG_INPMUX && Reg > REG_INPMUX;
+}
+
+/******************************************************************************
+function:   Send a prebuilt WREG frame
+parameter: 
+        Frame : CMD_WREG | first register, count - 1, data bytes
+        Len   : frame length, count + 2
+Info:
+    Always goes out on the bus; the shadow takes the written values.
+    Frame is copied, so a precomputed frame can be sent again.
+    A frame covering INPMUX counts as a mux select for ADS1263_SetVerify.
+******************************************************************************/
+void ADS1263_WriteRegFrame(ADS1263_DEVICE *Dev, const UBYTE *Frame, UBYTE Len)
+{
+    UBYTE buf[ADS1263_REG_NUM + 2];
+    if(Len < 3 || Len > sizeof(buf)) {
+        return;
+    }
+    memcpy(buf, Frame, Len);
+    ADS1263_Select(Dev);
+    DEV_Port_Transfer(Dev->Port, buf, Len);
+    ADS1263_Deselect(Dev);
+    if(ADS1263_ShadowFrame(Dev, Frame, Len)) {
+        ADS1263_VerifyReg(Dev, REG_INPMUX, "ADS1263_WriteRegFrame");
+    }
+}
+
+/* CRC-8, x^8 + x^2 + x + 1, MSB first: ADS1263_Crc8Table[b] = b * x^8 mod P */
+static const UBYTE ADS1263_Crc8Table[256] = {
+    0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b, 0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d,
+    0x70, 0x77, 0x7e, 0x79, 0x6c, 0x6b, 0x62, 0x65, 0x48, 0x4f, 0x46, 0x41, 0x54, 0x53, 0x5a, 0x5d,
+    0xe0, 0xe7, 0xee, 0xe9, 0xfc, 0xfb, 0xf2, 0xf5, 0xd8, 0xdf, 0xd6, 0xd1, 0xc4, 0xc3, 0xca, 0xcd,
+    0x90, 0x97, 0x9e, 0x99, 0x8c, 0x8b, 0x82, 0x85, 0xa8, 0xaf, 0xa6, 0xa1, 0xb4, 0xb3, 0xba, 0xbd,
+    0xc7, 0xc0, 0xc9, 0xce, 0xdb, 0xdc, 0xd5, 0xd2, 0xff, 0xf8, 0xf1, 0xf6, 0xe3, 0xe4, 0xed, 0xea,
+    0xb7, 0xb0, 0xb9, 0xbe, 0xab, 0xac, 0xa5, 0xa2, 0x8f, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9d, 0x9a,
+    0x27, 0x20, 0x29, 0x2e, 0x3b, 0x3c, 0x35, 0x32, 0x1f, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0d, 0x0a,
+    0x57, 0x50, 0x59, 0x5e, 0x4b, 0x4c, 0x45, 0x42, 0x6f, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7d, 0x7a,
+    0x89, 0x8e, 0x87, 0x80, 0x95, 0x92, 0x9b, 0x9c, 0xb1, 0xb6, 0xbf, 0xb8, 0xad, 0xaa, 0xa3, 0xa4,
+    0xf9, 0xfe, 0xf7, 0xf0, 0xe5, 0xe2, 0xeb, 0xec, 0xc1, 0xc6, 0xcf, 0xc8, 0xdd, 0xda, 0xd3, 0xd4,
+    0x69, 0x6e, 0x67, 0x60, 0x75, 0x72, 0x7b, 0x7c, 0x51, 0x56, 0x5f, 0x58, 0x4d, 0x4a, 0x43, 0x44,
+    0x19, 0x1e, 0x17, 0x10, 0x05, 0x02, 0x0b, 0x0c, 0x21, 0x26, 0x2f, 0x28, 0x3d, 0x3a, 0x33, 0x34,
+    0x4e, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5c, 0x5b, 0x76, 0x71, 0x78, 0x7f, 0x6a, 0x6d, 0x64, 0x63,
+    0x3e, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2c, 0x2b, 0x06, 0x01, 0x08, 0x0f, 0x1a, 0x1d, 0x14, 0x13,
+    0xae, 0xa9, 0xa0, 0xa7, 0xb2, 0xb5, 0xbc, 0xbb, 0x96, 0x91, 0x98, 0x9f, 0x8a, 0x8d, 0x84, 0x83,
+    0xde, 0xd9, 0xd0, 0xd7, 0xc2, 0xc5, 0xcc, 0xcb, 0xe6, 0xe1, 0xe8, 0xef, 0xfa, 0xfd, 0xf4, 0xf3,
+};
+
 /******************************************************************************
 function:   Check data
 parameter: 
-        val : 4 bytes(ADC2 is 3 bytes) data
-        byt : CRC byte
+        Mode : ADS1263_CRC_CHECKSUM or ADS1263_CRC_CRC8
+        val  : 4 data bytes, big-endian; ADC2 is 3 bytes and the pad byte, val << 8
+        byt  : CRC byte
 Info:
+        No loops or branches on the data: the checksum is the byte sum
+        plus 9Bh, the CRC four table steps.
         Check success, return 0
 ******************************************************************************/
-static UBYTE ADS1263_Checksum(UDOUBLE val, UBYTE byt)
+static inline UBYTE ADS1263_Checksum(UBYTE Mode, UDOUBLE val, UBYTE byt)
 {
-    UBYTE sum = 0;
-    UBYTE mask = -1;        // 8 bits mask, 0xff
-    while(val) {
-        sum += val & mask;  // only add the lower values
-        val >>= 8;          // shift down
+    UBYTE sum;
+    if(Mode == ADS1263_CRC_CRC8) {
+        sum = ADS1263_Crc8Table[ADS1263_CRC8_INIT ^ (val >> 24)];
+        sum = ADS1263_Crc8Table[sum ^ (UBYTE)(val >> 16)];
+        sum = ADS1263_Crc8Table[sum ^ (UBYTE)(val >> 8)];
+        sum = ADS1263_Crc8Table[sum ^ (UBYTE)val];
+    } else {
+        sum = (UBYTE)(val + (val >> 8) + (val >> 16) + (val >> 24) + 0x9b);
     }
-    sum += 0x9b;
-    // printf("--- %x %x--- \r\n", sum, byt);
     return sum ^ byt;       // if equal, this will be 0
 }
 
+/******************************************************************************
+function:   Verify a block of ADC1 samples
+parameter:
+    Sample : samples as read, e.g. a batch from ADS1263_Stream_Peek
+    Number : how many
+    Bad    : (Number + 31) / 32 words, bit i set: Sample[i] failed
+Info:
+    For readouts done with ADS1263_SetCrcDefer on: nothing is checked or
+    flagged per sample then, and one pass here costs a few ns per sample.
+    Samples with ADS1263_SAMPLE_TIMEOUT hold no frame and are not
+    flagged. Does not touch the samples, so a batch still in the ring
+    can be checked by the consumer. Failures add to ADS1263_GetErrors.
+    Return the number of failed samples
+******************************************************************************/
+UDOUBLE ADS1263_CheckBlock(ADS1263_DEVICE *Dev, const ADS1263_SAMPLE *Sample, UDOUBLE Number, UDOUBLE *Bad)
+{
+    UBYTE Mode = Dev->CrcMode;
+    UDOUBLE i, j, n, Mask, Count = 0;
+
+    for(i = 0; i < Number; i += 32) {
+        n = Number - i < 32 ? Number - i : 32;
+        Mask = 0;
+        if(Mode == ADS1263_CRC_CRC8) {
+            for(j = 0; j < n; j++)
+                Mask |= (UDOUBLE)((ADS1263_Checksum(ADS1263_CRC_CRC8, Sample[i + j].Value, Sample[i + j].CRC) != 0)
+                    & !(Sample[i + j].Flags & ADS1263_SAMPLE_TIMEOUT)) << j;
+        } else if(Mode == ADS1263_CRC_CHECKSUM) {
+            for(j = 0; j < n; j++)
+                Mask |= (UDOUBLE)((ADS1263_Checksum(ADS1263_CRC_CHECKSUM, Sample[i + j].Value, Sample[i + j].CRC) != 0)
+                    & !(Sample[i + j].Flags & ADS1263_SAMPLE_TIMEOUT)) << j;
+        }
+        Bad[i / 32] = Mask;
+        Count += __builtin_popcount(Mask);
+    }
+    if(Count)
+        atomic_fetch_add_explicit(&Dev->ErrCrc, Count, memory_order_relaxed);
+    return Count;
+}
+
 /******************************************************************************
 function:   Waiting for a busy end
 parameter: 
 Info:
     Timeout indicates that the operation is not working properly.
+    The timeout is at least twice the settling time, see GetSettle_us.
+    Return 0 data ready, 1 timeout
 ******************************************************************************/
-static void ADS1263_WaitDRDY(void)
+static UBYTE ADS1263_WaitDRDY(ADS1263_DEVICE *Dev)
 {
+    // a slow filter with chop can settle for longer than the fixed timeout
+    UDOUBLE Timeout = 2 * ADS1263_GetSettle_us(Dev);
+    if(Timeout < ADS1263_DRDY_TIMEOUT_US)
+        Timeout = ADS1263_DRDY_TIMEOUT_US;
+    uint64_t t0 = ADS1263_Stats_Begin(Dev);
     // printf("ADS1263_WaitDRDY \r\n");
-    UDOUBLE i = 0;
-    while(1) {
-        if(DEV_Digital_Read(DEV_DRDY_PIN) == 0)
-            break;
-        if(i >= 4000000) {
-            printf("Time Out ...\r\n"); 
-            break;
-        }
-    }   
+    if(DEV_Port_Wait_DRDY(Dev->Port, Timeout) != 0) {
+        atomic_fetch_add_explicit(&Dev->ErrTimeout, 1, memory_order_relaxed);
+        ADS1263_Stats_Event(Dev, ADS1263_COUNT_TIMEOUT);
+        Log_Error_Limit("Time Out ...\r\n");
+        return 1;
+    }
+    ADS1263_Stats_End(Dev, ADS1263_STAGE_WAIT, t0);
     // printf("ADS1263_WaitDRDY Release \r\n");
+    return 0;
 }
 
 /******************************************************************************
@@ -141,10 +608,10 @@ function:  Read device ID
 parameter: 
 Info:
 ******************************************************************************/
-UBYTE ADS1263_ReadChipID(void)
+UBYTE ADS1263_ReadChipID(ADS1263_DEVICE *Dev)
 {
     UBYTE id;
-    id = ADS1263_Read_data(REG_ID);
+    id = ADS1263_Read_data(Dev, REG_ID);
     return id>>5;
 }
 
@@ -155,56 +622,104 @@ parameter:
            1 channel1 Differential input
 Info:
 ******************************************************************************/
-void ADS1263_SetMode(UBYTE Mode)
+void ADS1263_SetMode(ADS1263_DEVICE *Dev, UBYTE Mode)
 {
     if(Mode == 0) {
-        ScanMode = 0;
+        Dev->ScanMode = 0;
     }else {
-        ScanMode = 1;
+        Dev->ScanMode = 1;
     }
 }
 
+/******************************************************************************
+function:  Fill in the ADC1 set-up init_ADC1 has always used
+parameter: 
+    Config : set-up to fill
+    Rate   : data rate
+Info:
+    FIR filter, PGA bypassed, no chop, 35us delay, AVDD/AVSS reference.
+    Change fields and pass it to ADS1263_ConfigureADC1.
+******************************************************************************/
+void ADS1263_ADC1_DefaultConfig(ADS1263_ADC1_CONFIG *Config, ADS1263_DRATE Rate)
+{
+    Config->Rate = Rate;
+    Config->Filter = ADS1263_FIR;
+    Config->Gain = ADS1263_GAIN_1;
+    Config->Bypass = 1;
+    Config->Chop = ADS1263_CHOP_OFF;
+    Config->Delay = ADS1263_DELAY_35us;
+    Config->RefMux = 0x24;      //0x00:+-2.5V as REF, 0x24:VDD,VSS as REF
+    Config->SensorBias = 0x04;
+}
+
+/******************************************************************************
+function:  Program filter, PGA, chop, delay and reference of ADC1
+parameter: 
+    Config : set-up, see ADS1263_ADC1_DefaultConfig
+Info:
+    MODE0 to MODE2 go out as one WREG and REFMUX as a second, in one
+    chip-select window. One RREG of MODE0 to REFMUX reads them back.
+    ADS1263_GetSettle_us and the DRDY timeout follow the new filter and
+    rate from the register shadow.
+    Return 0 success, 1 bad set-up or a register did not take
+******************************************************************************/
+UBYTE ADS1263_ConfigureADC1(ADS1263_DEVICE *Dev, const ADS1263_ADC1_CONFIG *Config)
+{
+    static const char *Name[4] = {"REG_MODE0", "REG_MODE1", "REG_MODE2", "REG_REFMUX"};
+    UBYTE Reg[4] = {REG_MODE0, REG_MODE1, REG_MODE2, REG_REFMUX};
+    UBYTE Value[4], Mode[5], Ref[3], Back[REG_REFMUX - REG_MODE0 + 1], i, err = 0;
+    ADS1263_CHAIN Chain;
+
+    if(Config->Rate > ADS1263_38400SPS || Config->Filter > ADS1263_FIR || Config->Gain > ADS1263_GAIN_64
+        || Config->Chop > ADS1263_CHOP_BOTH || Config->Delay > ADS1263_DELAY_8d8ms) {
+        Log_Error("ADS1263_ConfigureADC1: bad set-up \r\n");
+        return 1;
+    }
+    Value[0] = (Config->Chop << 4) | Config->Delay;                 // continuous conversions
+    Value[1] = (Config->Filter << 5) | (Config->SensorBias & 0x1f);
+    Value[2] = (Config->Bypass ? 0x80 : 0x00) | (Config->Gain << 4) | Config->Rate;
+    Value[3] = Config->RefMux;
+
+    Mode[0] = CMD_WREG | REG_MODE0;
+    Mode[1] = CMD_WREG2 | 2;
+    memcpy(&Mode[2], Value, 3);
+    Ref[0] = CMD_WREG | REG_REFMUX;
+    Ref[1] = CMD_WREG2;
+    Ref[2] = Value[3];
+    ADS1263_Chain_Init(&Chain);
+    ADS1263_Chain_WriteRegFrame(&Chain, Mode, sizeof(Mode));
+    ADS1263_Chain_WriteRegFrame(&Chain, Ref, sizeof(Ref));
+    ADS1263_Chain_Run(Dev, &Chain);
+
+    ADS1263_ReadRegs(Dev, REG_MODE0, sizeof(Back), Back);
+    for(i = 0; i < 4; i++) {
+        if(Back[Reg[i] - REG_MODE0] == Value[i]) {
+            Log_Debug("%s success \r\n", Name[i]);
+        } else {
+            Log_Error("%s unsuccess \r\n", Name[i]);
+            atomic_fetch_add_explicit(&Dev->ErrConfig, 1, memory_order_relaxed);
+            err = 1;
+        }
+    }
+    return err;
+}
+
 /******************************************************************************
 function:  Configure ADC gain and sampling speed
 parameter: 
     gain : Enumeration type gain
     drate: Enumeration type sampling speed
 Info:
+    The default set-up with the gain, rate and delay given;
+    the PGA stays bypassed, as it always was here
 ******************************************************************************/
-void ADS1263_ConfigADC1(ADS1263_GAIN gain, ADS1263_DRATE drate, ADS1263_DELAY delay)
+void ADS1263_ConfigADC1(ADS1263_DEVICE *Dev, ADS1263_GAIN gain, ADS1263_DRATE drate, ADS1263_DELAY delay)
 {
-    UBYTE MODE2 = 0x80;             //0x80:PGA bypassed, 0x00:PGA enabled
-    MODE2 |= (gain << 4) | drate;
-    ADS1263_WriteReg(REG_MODE2, MODE2);
-    DEV_Delay_ms(1);
-    if(ADS1263_Read_data(REG_MODE2) == MODE2)
-        printf("REG_MODE2 success \r\n");
-    else
-        printf("REG_MODE2 unsuccess \r\n");
-    
-    UBYTE REFMUX = 0x24;        //0x00:+-2.5V as REF, 0x24:VDD,VSS as REF
-    ADS1263_WriteReg(REG_REFMUX, REFMUX);
-    DEV_Delay_ms(1);
-    if(ADS1263_Read_data(REG_REFMUX) == REFMUX)
-        printf("REG_REFMUX success \r\n");
-    else
-        printf("REG_REFMUX unsuccess \r\n");
-    
-    UBYTE MODE0 = delay;
-    ADS1263_WriteReg(REG_MODE0, MODE0); 
-    DEV_Delay_ms(1);
-    if(ADS1263_Read_data(REG_MODE0) == MODE0)
-        printf("REG_MODE0 success \r\n");
-    else
-        printf("REG_MODE0 unsuccess \r\n");
-    
-    UBYTE MODE1 = 0x84; // Digital Filter; 0x84:FIR, 0x64:Sinc4, 0x44:Sinc3, 0x24:Sinc2, 0x04:Sinc1
-    ADS1263_WriteReg(REG_MODE1, MODE1); 
-    DEV_Delay_ms(1);
-    if(ADS1263_Read_data(REG_MODE1) == MODE1)
-        printf("REG_MODE1 success \r\n");
-    else
-        printf("REG_MODE1 unsuccess \r\n");
+    ADS1263_ADC1_CONFIG Config;
+    ADS1263_ADC1_DefaultConfig(&Config, drate);
+    Config.Gain = gain;
+    Config.Delay = delay;
+    ADS1263_ConfigureADC1(Dev, &Config);
 }
 
 /******************************************************************************
@@ -214,58 +729,154 @@ parameter:
     drate: Enumeration type sampling speed
 Info:
 ******************************************************************************/
-void ADS1263_ConfigADC2(ADS1263_ADC2_GAIN gain, ADS1263_ADC2_DRATE drate, ADS1263_DELAY delay)
+void ADS1263_ConfigADC2(ADS1263_DEVICE *Dev, ADS1263_ADC2_GAIN gain, ADS1263_ADC2_DRATE drate, ADS1263_DELAY delay)
 {
     UBYTE ADC2CFG = 0x20;               //REF, 0x20:VAVDD and VAVSS, 0x00:+-2.5V
     ADC2CFG |= (drate << 6) | gain;
-    ADS1263_WriteReg(REG_ADC2CFG, ADC2CFG);
-    DEV_Delay_ms(1);
-    if(ADS1263_Read_data(REG_ADC2CFG) == ADC2CFG)
-        printf("REG_ADC2CFG success \r\n");
-    else
-        printf("REG_ADC2CFG unsuccess \r\n");
+    ADS1263_WriteReg(Dev, REG_ADC2CFG, ADC2CFG);
+    if(ADS1263_Read_data(Dev, REG_ADC2CFG) == ADC2CFG) {
+        Log_Debug("REG_ADC2CFG success \r\n");
+    } else {
+        Log_Error("REG_ADC2CFG unsuccess \r\n");
+        atomic_fetch_add_explicit(&Dev->ErrConfig, 1, memory_order_relaxed);
+    }
     
     UBYTE MODE0 = delay;
-    ADS1263_WriteReg(REG_MODE0, MODE0); 
-    DEV_Delay_ms(1);
-    if(ADS1263_Read_data(REG_MODE0) == MODE0)
-        printf("REG_MODE0 success \r\n");
-    else
-        printf("REG_MODE0 unsuccess \r\n");
+    ADS1263_WriteReg(Dev, REG_MODE0, MODE0); 
+    if(ADS1263_Read_data(Dev, REG_MODE0) == MODE0) {
+        Log_Debug("REG_MODE0 success \r\n");
+    } else {
+        Log_Error("REG_MODE0 unsuccess \r\n");
+        atomic_fetch_add_explicit(&Dev->ErrConfig, 1, memory_order_relaxed);
+    }
 }
 
 /******************************************************************************
-function:  Device initialization
+function:  Reset the chip and check that it answers
 parameter: 
 Info:
+    See ADS1263_SetFastStart.
+    Return 0 success, 1 no chip
 ******************************************************************************/
-UBYTE ADS1263_init_ADC1(ADS1263_DRATE rate)
+static UBYTE ADS1263_Start(ADS1263_DEVICE *Dev)
 {
-    ADS1263_reset();
-    if(ADS1263_ReadChipID() == 1) {
-        printf("ID Read success \r\n");
+    UBYTE id;
+    ADS1263_reset(Dev);
+    id = ADS1263_ReadChipID(Dev);
+    if(id != 1 && Dev->FastStart) {
+        Log_Warn("ID Read failed after fast reset, retrying \r\n");
+        Dev->FastStart = 0;
+        ADS1263_reset(Dev);
+        Dev->FastStart = 1;
+        id = ADS1263_ReadChipID(Dev);
+    }
+    if(id == 1) {
+        Log_Info("ID Read success \r\n");
     }
     else {
-        printf("ID Read failed \r\n");
+        Log_Error("ID Read failed \r\n");
         return 1;
     }
-    ADS1263_WriteCmd(CMD_STOP1);
-    ADS1263_ConfigADC1(ADS1263_GAIN_1, rate, ADS1263_DELAY_35us);
-    ADS1263_WriteCmd(CMD_START1);
     return 0;
 }
-UBYTE ADS1263_init_ADC2(ADS1263_ADC2_DRATE rate)
+
+/******************************************************************************
+function:  Run one ADC1 calibration command
+parameter: 
+    Cmd : CMD_SFOCAL1 self offset, CMD_SYOCAL1 system offset (inputs at zero),
+          CMD_SYGCAL1 system gain (inputs at full scale)
+Info:
+    ADC1 must be converting with the gain and rate to calibrate. The chip
+    averages 16 conversions, writes OFCAL or FSCAL and then drives DRDY
+    low. OFCAL0 to FSCAL2 are read back into the shadow in one RREG.
+    Return 0 success, 1 bad command or timeout
+******************************************************************************/
+UBYTE ADS1263_Calibrate(ADS1263_DEVICE *Dev, UBYTE Cmd)
 {
-    ADS1263_reset();
-    if(ADS1263_ReadChipID() == 1) {
-        printf("ID Read success \r\n");
+    UBYTE Cal[6];
+    UDOUBLE Timeout;
+
+    if(Cmd != CMD_SFOCAL1 && Cmd != CMD_SYOCAL1 && Cmd != CMD_SYGCAL1) {
+        return 1;
     }
-    else {
-        printf("ID Read failed \r\n");
+    // first settled result plus 16 more, twice over
+    Timeout = 2 * 17 * ADS1263_GetSettle_us(Dev);
+    if(Timeout < ADS1263_DRDY_TIMEOUT_US)
+        Timeout = ADS1263_DRDY_TIMEOUT_US;
+    ADS1263_WriteCmd(Dev, Cmd);
+    DEV_Delay_us(ADS1263_START_US);
+    if(DEV_Port_Wait_DRDY(Dev->Port, Timeout) != 0) {
+        atomic_fetch_add_explicit(&Dev->ErrTimeout, 1, memory_order_relaxed);
+        Log_Error("ADS1263_Calibrate: Time Out ...\r\n");
+        return 1;
+    }
+    ADS1263_ReadRegs(Dev, REG_OFCAL0, sizeof(Cal), Cal);
+    return 0;
+}
+
+/******************************************************************************
+function:  Device initialization
+parameter: 
+Info:
+******************************************************************************/
+UBYTE ADS1263_init_ADC1(ADS1263_DEVICE *Dev, ADS1263_DRATE rate)
+{
+    ADS1263_ADC1_CONFIG Config;
+    ADS1263_ADC1_DefaultConfig(&Config, rate);
+    return ADS1263_init_ADC1_Config(Dev, &Config);
+}
+
+/******************************************************************************
+function:  Device initialization with a full ADC1 set-up
+parameter: 
+    Config : filter, PGA, chop, delay and reference
+Info:
+    As ADS1263_init_ADC1, e.g. sinc1 at 38400 SPS for fast scans.
+    A set-up that does not take is reported but ADC1 is still started.
+    Return 0 success, 1 no chip
+******************************************************************************/
+UBYTE ADS1263_init_ADC1_Config(ADS1263_DEVICE *Dev, const ADS1263_ADC1_CONFIG *Config)
+{
+    if(ADS1263_Start(Dev) != 0) {
         return 1;
     }
-    ADS1263_WriteCmd(CMD_STOP2);
-    ADS1263_ConfigADC2(ADS1263_ADC2_GAIN_1, rate, ADS1263_DELAY_35us);
+    ADS1263_WriteCmd(Dev, CMD_STOP1);
+    ADS1263_ConfigureADC1(Dev, Config);
+    ADS1263_WriteCmd(Dev, CMD_START1);
+    return 0;
+}
+UBYTE ADS1263_init_ADC2(ADS1263_DEVICE *Dev, ADS1263_ADC2_DRATE rate)
+{
+    if(ADS1263_Start(Dev) != 0) {
+        return 1;
+    }
+    ADS1263_WriteCmd(Dev, CMD_STOP2);
+    ADS1263_ConfigADC2(Dev, ADS1263_ADC2_GAIN_1, rate, ADS1263_DELAY_35us);
+    return 0;
+}
+
+/******************************************************************************
+function:  Device initialization, both converters running
+parameter: 
+    rate1 : ADC1 data rate
+    rate2 : ADC2 data rate
+Info:
+    One reset, then ADC1 and ADC2 are configured and started together.
+    Read them with ADS1263_ReadDual; ADS1263_GetChannalValue_ADC2 and
+    ADS1263_GetAll_ADC2 stop ADC2 and do not belong in this mode.
+******************************************************************************/
+UBYTE ADS1263_init_Dual(ADS1263_DEVICE *Dev, ADS1263_DRATE rate1, ADS1263_ADC2_DRATE rate2)
+{
+    if(ADS1263_Start(Dev) != 0) {
+        return 1;
+    }
+    ADS1263_WriteCmd(Dev, CMD_STOP1);
+    ADS1263_WriteCmd(Dev, CMD_STOP2);
+    ADS1263_ConfigADC1(Dev, ADS1263_GAIN_1, rate1, ADS1263_DELAY_35us);
+    ADS1263_ConfigADC2(Dev, ADS1263_ADC2_GAIN_1, rate2, ADS1263_DELAY_35us);
+    Dev->DualNumber = 0;
+    ADS1263_WriteCmd(Dev, CMD_START1);
+    ADS1263_WriteCmd(Dev, CMD_START2);
     return 0;
 }
 
@@ -275,18 +886,16 @@ parameter:
     Channal : Set channel number
 Info:
 ******************************************************************************/
-static void ADS1263_SetChannal(UBYTE Channal)
+static void ADS1263_SetChannal(ADS1263_DEVICE *Dev, UBYTE Channal)
 {
     if(Channal > 10) {
         return ;
     }
     UBYTE INPMUX = (Channal << 4) | 0x0a;       //0x0a:VCOM as Negative Input
-    ADS1263_WriteReg(REG_INPMUX, INPMUX);
-    if(ADS1263_Read_data(REG_INPMUX) == INPMUX) {
-        // printf("ADS1263_ADC1_SetChannal success \r\n");
-    } else {
-        printf("ADS1263_ADC1_SetChannal unsuccess \r\n");
-    }
+    uint64_t t0 = ADS1263_Stats_Begin(Dev);
+    ADS1263_WriteReg(Dev, REG_INPMUX, INPMUX);
+    ADS1263_VerifyReg(Dev, REG_INPMUX, "ADS1263_ADC1_SetChannal");
+    ADS1263_Stats_End(Dev, ADS1263_STAGE_MUX, t0);
 }
 
 /******************************************************************************
@@ -295,18 +904,17 @@ parameter:
     Channal : Set channel number
 Info:
 ******************************************************************************/
-static void ADS1263_SetChannal_ADC2(UBYTE Channal)
+static void ADS1263_SetChannal_ADC2(ADS1263_DEVICE *Dev, UBYTE Channal)
 {
     if(Channal > 10) {
         return ;
     }
     UBYTE INPMUX = (Channal << 4) | 0x0a;       //0x0a:VCOM as Negative Input
-    ADS1263_WriteReg(REG_ADC2MUX, INPMUX);
-    if(ADS1263_Read_data(REG_ADC2MUX) == INPMUX) {
-        // printf("ADS1263_ADC2_SetChannal success \r\n");
-    } else {
-        printf("ADS1263_ADC2_SetChannal unsuccess \r\n");
-    }
+    uint64_t t0 = ADS1263_Stats_Begin(Dev);
+    ADS1263_WriteReg(Dev, REG_ADC2MUX, INPMUX);
+    Dev->ADC2Channel = Channal;
+    ADS1263_VerifyReg(Dev, REG_ADC2MUX, "ADS1263_ADC2_SetChannal");
+    ADS1263_Stats_End(Dev, ADS1263_STAGE_MUX, t0);
 }
 
 /******************************************************************************
@@ -315,7 +923,7 @@ parameter:
     Channal : Set channel number
 Info:
 ******************************************************************************/
-void ADS1263_SetDiffChannal(UBYTE Channal)
+void ADS1263_SetDiffChannal(ADS1263_DEVICE *Dev, UBYTE Channal)
 {
     UBYTE INPMUX;
     if (Channal == 0) {
@@ -328,13 +936,13 @@ void ADS1263_SetDiffChannal(UBYTE Channal)
         INPMUX = (6<<4) | 7;    //DiffChannal   AIN6-AIN7
     } else if(Channal == 4) {
         INPMUX = (8<<4) | 9;    //DiffChannal   AIN8-AIN9
-    }
-    ADS1263_WriteReg(REG_INPMUX, INPMUX);   
-    if(ADS1263_Read_data(REG_INPMUX) == INPMUX) {
-        // printf("ADS1263_SetDiffChannal success \r\n");
     } else {
-        printf("ADS1263_SetDiffChannal unsuccess \r\n");
+        return;
     }
+    uint64_t t0 = ADS1263_Stats_Begin(Dev);
+    ADS1263_WriteReg(Dev, REG_INPMUX, INPMUX);   
+    ADS1263_VerifyReg(Dev, REG_INPMUX, "ADS1263_SetDiffChannal");
+    ADS1263_Stats_End(Dev, ADS1263_STAGE_MUX, t0);
 }
 
 /******************************************************************************
@@ -343,7 +951,7 @@ parameter:
     Channal : Set channel number
 Info:
 ******************************************************************************/
-void ADS1263_SetDiffChannal_ADC2(UBYTE Channal)
+void ADS1263_SetDiffChannal_ADC2(ADS1263_DEVICE *Dev, UBYTE Channal)
 {
     UBYTE INPMUX;
     if (Channal == 0) {
@@ -356,46 +964,117 @@ void ADS1263_SetDiffChannal_ADC2(UBYTE Channal)
         INPMUX = (6<<4) | 7;    //DiffChannal   AIN6-AIN7
     } else if(Channal == 4) {
         INPMUX = (8<<4) | 9;    //DiffChannal   AIN8-AIN9
-    }
-    ADS1263_WriteReg(REG_ADC2MUX, INPMUX);  
-    if(ADS1263_Read_data(REG_ADC2MUX) == INPMUX) {
-        // printf("ADS1263_SetDiffChannal_ADC2 success \r\n");
     } else {
-        printf("ADS1263_SetDiffChannal_ADC2 unsuccess \r\n");
+        return;
     }
+    uint64_t t0 = ADS1263_Stats_Begin(Dev);
+    ADS1263_WriteReg(Dev, REG_ADC2MUX, INPMUX);  
+    Dev->ADC2Channel = Channal;
+    ADS1263_VerifyReg(Dev, REG_ADC2MUX, "ADS1263_SetDiffChannal_ADC2");
+    ADS1263_Stats_End(Dev, ADS1263_STAGE_MUX, t0);
 }
 
 /******************************************************************************
-function:  Read ADC data
+function:  Check a data frame
 parameter: 
+    Value  : data field as received, see ADS1263_Checksum
+    Crc    : checksum byte as received
+    Sample : flagged ADS1263_SAMPLE_CRC_ERR on a mismatch
 Info:
+    Counts and times the check for ADS1263_SetStats. Skipped with the
+    check off or deferred to ADS1263_CheckBlock.
 ******************************************************************************/
-static UDOUBLE ADS1263_Read_ADC1_Data(void)
+static void ADS1263_CheckFrame(ADS1263_DEVICE *Dev, UDOUBLE Value, UBYTE Crc, ADS1263_SAMPLE *Sample)
+{
+    uint64_t t0;
+    UBYTE Bad;
+
+    ADS1263_Stats_Event(Dev, ADS1263_COUNT_SAMPLE);
+    if(Dev->CrcMode == ADS1263_CRC_OFF || Dev->CrcDefer) {
+        return;
+    }
+    t0 = ADS1263_Stats_Begin(Dev);
+    Bad = ADS1263_Checksum(Dev->CrcMode, Value, Crc);
+    ADS1263_Stats_End(Dev, ADS1263_STAGE_CRC, t0);
+    if(Bad != 0) {
+        Sample->Flags |= ADS1263_SAMPLE_CRC_ERR;
+        atomic_fetch_add_explicit(&Dev->ErrCrc, 1, memory_order_relaxed);
+        ADS1263_Stats_Event(Dev, ADS1263_COUNT_CRC);
+    }
+}
+
+/******************************************************************************
+function:  Unpack an RDATA1 frame
+parameter: 
+    buf    : command, status, 4 data bytes, CRC as received
+    Sample : receives code, status byte, CRC byte and flags
+Info:
+******************************************************************************/
+static void ADS1263_Decode_ADC1(ADS1263_DEVICE *Dev, const UBYTE *buf, ADS1263_SAMPLE *Sample)
 {
     UDOUBLE read = 0;
-    UBYTE buf[4] = {0, 0, 0, 0};
-    UBYTE Status, CRC;
-    DEV_Digital_Write(DEV_CS_PIN, 0);
-    do {
-        DEV_SPI_WriteByte(CMD_RDATA1);
-        // DEV_Delay_ms(10);
-        Status = DEV_SPI_ReadByte();
-    }while((Status & 0x40) == 0);
-    
-    buf[0] = DEV_SPI_ReadByte();
-    buf[1] = DEV_SPI_ReadByte();
-    buf[2] = DEV_SPI_ReadByte();
-    buf[3] = DEV_SPI_ReadByte();
-    CRC = DEV_SPI_ReadByte();
-    DEV_Digital_Write(DEV_CS_PIN, 1);
-    read |= ((UDOUBLE)buf[0] << 24);
-    read |= ((UDOUBLE)buf[1] << 16);
-    read |= ((UDOUBLE)buf[2] << 8);
-    read |= (UDOUBLE)buf[3];
-    // printf("%x %x %x %x %x %x\r\n", Status, buf[0], buf[1], buf[2], buf[3], CRC);
-    if(ADS1263_Checksum(read, CRC) != 0)
-        printf("ADC1 Data read error! \r\n");
-    return read;
+    read |= ((UDOUBLE)buf[2] << 24);
+    read |= ((UDOUBLE)buf[3] << 16);
+    read |= ((UDOUBLE)buf[4] << 8);
+    read |= (UDOUBLE)buf[5];
+    // printf("%x %x %x %x %x %x\r\n", buf[1], buf[2], buf[3], buf[4], buf[5], buf[6]);
+    Sample->Value = read;
+    Sample->Status = buf[1];
+    Sample->CRC = buf[6];
+    Sample->Flags = 0;
+    ADS1263_CheckFrame(Dev, read, buf[6], Sample);
+}
+
+/******************************************************************************
+function:  Give up on a readout that never showed new data
+parameter: 
+    Sample : flagged ADS1263_SAMPLE_TIMEOUT, Value 0
+Info:
+    A board that answers with the new-data bit always clear (MISO stuck
+    low, no clock) is counted as a timeout instead of hanging the bus.
+******************************************************************************/
+static void ADS1263_Read_Timeout(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample)
+{
+    Sample->Value = 0;
+    Sample->Status = Sample->CRC = 0;
+    Sample->Flags = ADS1263_SAMPLE_TIMEOUT;
+    atomic_fetch_add_explicit(&Dev->ErrTimeout, 1, memory_order_relaxed);
+    ADS1263_Stats_Event(Dev, ADS1263_COUNT_TIMEOUT);
+    Log_Error_Limit("No new data ...\r\n");
+}
+
+/******************************************************************************
+function:  Read one ADC1 conversion frame
+parameter: 
+    Sample : receives code, status byte, CRC byte and flags
+Info:
+    Time_ns and Channel are left to the caller. A frame without the
+    new-data bit is read again, at most ADS1263_READ_RETRY times.
+    Return 0 success, 1 no new data (ADS1263_SAMPLE_TIMEOUT)
+******************************************************************************/
+static UBYTE ADS1263_Read_ADC1_Frame(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample)
+{
+    UBYTE buf[ADS1263_DATA_FRAME];
+    UBYTE i;
+    uint64_t t0 = ADS1263_Stats_Begin(Dev);
+    ADS1263_Select(Dev);
+    for(i = 0; ; i++) {
+        // command, status, 4 data bytes, CRC in one transfer
+        memset(buf, 0, sizeof(buf));
+        buf[0] = CMD_RDATA1;
+        DEV_Port_Transfer(Dev->Port, buf, ADS1263_DATA_FRAME);
+        if((buf[1] & 0x40) || i == ADS1263_READ_RETRY)
+            break;
+        ADS1263_Stats_Event(Dev, ADS1263_COUNT_RETRY);
+    }
+    ADS1263_Deselect(Dev);
+    ADS1263_Stats_End(Dev, ADS1263_STAGE_READ, t0);
+    if(!(buf[1] & 0x40)) {
+        ADS1263_Read_Timeout(Dev, Sample);
+        return 1;
+    }
+    ADS1263_Decode_ADC1(Dev, buf, Sample);
+    return 0;
 }
 
 /******************************************************************************
@@ -403,32 +1082,71 @@ function:  Read ADC data
 parameter: 
 Info:
 ******************************************************************************/
-static UDOUBLE ADS1263_Read_ADC2_Data(void)
+static UDOUBLE ADS1263_Read_ADC1_Data(ADS1263_DEVICE *Dev)
+{
+    ADS1263_SAMPLE Sample;
+    ADS1263_Read_ADC1_Frame(Dev, &Sample);
+    if(Sample.Flags & ADS1263_SAMPLE_CRC_ERR)
+        Log_Warn_Limit("ADC1 Data read error! \r\n");
+    return Sample.Value;
+}
+
+/******************************************************************************
+function:  Read one ADC2 data frame
+parameter: 
+    Sample : receives code, status byte, CRC byte and flags
+Info:
+    Time_ns and Channel are left to the caller. A frame without the
+    new-data bit is read again, at most ADS1263_READ_RETRY times.
+    Return 0 success, 1 no new data (ADS1263_SAMPLE_TIMEOUT)
+******************************************************************************/
+static UBYTE ADS1263_Read_ADC2_Frame(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample)
 {
     UDOUBLE read = 0;
-    UBYTE buf[4] = {0, 0, 0, 0};
-    UBYTE Status, CRC;
-    
-    DEV_Digital_Write(DEV_CS_PIN, 0);
-    do {
-        DEV_SPI_WriteByte(CMD_RDATA2);
-        // DEV_Delay_ms(10);
-        Status = DEV_SPI_ReadByte();
-    }while((Status & 0x80) == 0);
+    UBYTE buf[ADS1263_DATA_FRAME];
+    UBYTE i;
     
-    buf[0] = DEV_SPI_ReadByte();
-    buf[1] = DEV_SPI_ReadByte();
-    buf[2] = DEV_SPI_ReadByte();
-    buf[3] = DEV_SPI_ReadByte();
-    CRC = DEV_SPI_ReadByte();
-    DEV_Digital_Write(DEV_CS_PIN, 1);
-    read |= ((UDOUBLE)buf[0] << 16);
-    read |= ((UDOUBLE)buf[1] << 8);
-    read |= (UDOUBLE)buf[2];
-    // printf("%x %x %x %x %x\r\n", Status, buf[0], buf[1], buf[2], CRC);
-    if(ADS1263_Checksum(read, CRC) != 0)
-        printf("ADC2 Data read error! \r\n");
-    return read;
+    uint64_t t0 = ADS1263_Stats_Begin(Dev);
+    ADS1263_Select(Dev);
+    for(i = 0; ; i++) {
+        // command, status, 3 data bytes, pad byte, CRC in one transfer
+        memset(buf, 0, sizeof(buf));
+        buf[0] = CMD_RDATA2;
+        DEV_Port_Transfer(Dev->Port, buf, ADS1263_DATA_FRAME);
+        if((buf[1] & 0x80) || i == ADS1263_READ_RETRY)
+            break;
+        ADS1263_Stats_Event(Dev, ADS1263_COUNT_RETRY);
+    }
+    ADS1263_Deselect(Dev);
+    ADS1263_Stats_End(Dev, ADS1263_STAGE_READ, t0);
+    if(!(buf[1] & 0x80)) {
+        ADS1263_Read_Timeout(Dev, Sample);
+        return 1;
+    }
+    read |= ((UDOUBLE)buf[2] << 16);
+    read |= ((UDOUBLE)buf[3] << 8);
+    read |= (UDOUBLE)buf[4];
+    // printf("%x %x %x %x %x\r\n", buf[1], buf[2], buf[3], buf[4], buf[6]);
+    Sample->Value = read;
+    Sample->Status = buf[1];
+    Sample->CRC = buf[6];
+    Sample->Flags = 0;
+    ADS1263_CheckFrame(Dev, read << 8, buf[6], Sample);
+    return 0;
+}
+
+/******************************************************************************
+function:  Read ADC data
+parameter: 
+Info:
+******************************************************************************/
+static UDOUBLE ADS1263_Read_ADC2_Data(ADS1263_DEVICE *Dev)
+{
+    ADS1263_SAMPLE Sample;
+    ADS1263_Read_ADC2_Frame(Dev, &Sample);
+    if(Sample.Flags & ADS1263_SAMPLE_CRC_ERR)
+        Log_Warn_Limit("ADC2 Data read error! \r\n");
+    return Sample.Value;
 }
 
 /******************************************************************************
@@ -437,29 +1155,33 @@ parameter:
     Channel: Channel number
 Info:
 ******************************************************************************/
-UDOUBLE ADS1263_GetChannalValue(UBYTE Channel)
+UDOUBLE ADS1263_GetChannalValue(ADS1263_DEVICE *Dev, UBYTE Channel)
 {
     UDOUBLE Value = 0;
-    if(ScanMode == 0) {// 0  Single-ended input  10 channel1 Differential input  5 channe 
+    if(Dev->ScanMode == 0) {// 0  Single-ended input  10 channel1 Differential input  5 channe 
         if(Channel>10) {
             return 0;
         }
-        ADS1263_SetChannal(Channel);
+        ADS1263_SetChannal(Dev, Channel);
         // DEV_Delay_ms(2);
         // ADS1263_WriteCmd(CMD_START1);
         // DEV_Delay_ms(2);
-        ADS1263_WaitDRDY();
-        Value = ADS1263_Read_ADC1_Data();
+        if(ADS1263_WaitDRDY(Dev) != 0) {
+            return 0;
+        }
+        Value = ADS1263_Read_ADC1_Data(Dev);
     } else {
         if(Channel>4) {
             return 0;
         }
-        ADS1263_SetDiffChannal(Channel);
+        ADS1263_SetDiffChannal(Dev, Channel);
         // DEV_Delay_ms(2);
         // ADS1263_WriteCmd(CMD_START1);
         // DEV_Delay_ms(2);
-        ADS1263_WaitDRDY();
-        Value = ADS1263_Read_ADC1_Data();
+        if(ADS1263_WaitDRDY(Dev) != 0) {
+            return 0;
+        }
+        Value = ADS1263_Read_ADC1_Data(Dev);
     }
     // printf("Get IN%d value success \r\n", Channel);
     return Value;
@@ -471,43 +1193,394 @@ parameter:
     Channel: Channel number
 Info:
 ******************************************************************************/
-UDOUBLE ADS1263_GetChannalValue_ADC2(UBYTE Channel)
+UDOUBLE ADS1263_GetChannalValue_ADC2(ADS1263_DEVICE *Dev, UBYTE Channel)
 {
     UDOUBLE Value = 0;
-    if(ScanMode == 0) {// 0  Single-ended input  10 channel1 Differential input  5 channe 
+    if(Dev->ScanMode == 0) {// 0  Single-ended input  10 channel1 Differential input  5 channe 
         if(Channel>10) {
             return 0;
         }
-        ADS1263_SetChannal_ADC2(Channel);
+        ADS1263_SetChannal_ADC2(Dev, Channel);
         // DEV_Delay_ms(2);
-        ADS1263_WriteCmd(CMD_START2);
+        ADS1263_WriteCmd(Dev, CMD_START2);
         // DEV_Delay_ms(2);
-        Value = ADS1263_Read_ADC2_Data();
+        Value = ADS1263_Read_ADC2_Data(Dev);
     } else {
         if(Channel>4) {
             return 0;
         }
-        ADS1263_SetDiffChannal_ADC2(Channel);
+        ADS1263_SetDiffChannal_ADC2(Dev, Channel);
         // DEV_Delay_ms(2);
-        ADS1263_WriteCmd(CMD_START2);
+        ADS1263_WriteCmd(Dev, CMD_START2);
         // DEV_Delay_ms(2);
-        Value = ADS1263_Read_ADC2_Data();
+        Value = ADS1263_Read_ADC2_Data(Dev);
     }
     // printf("Get IN%d value success \r\n", Channel);
     return Value;
 }
 
+/******************************************************************************
+function:  Select the ADC1 input for the current mode
+parameter: 
+    Channel: Channel number, 0-10 single-ended, 0-4 differential
+Info:
+    Return 0 success, 1 channel out of range
+******************************************************************************/
+UBYTE ADS1263_SelectChannal(ADS1263_DEVICE *Dev, UBYTE Channel)
+{
+    if(Dev->ScanMode == 0) {
+        if(Channel>10) {
+            return 1;
+        }
+        ADS1263_SetChannal(Dev, Channel);
+    } else {
+        if(Channel>4) {
+            return 1;
+        }
+        ADS1263_SetDiffChannal(Dev, Channel);
+    }
+    return 0;
+}
+
+/******************************************************************************
+function:  Select the ADC2 input for the current mode
+parameter: 
+    Channel: Channel number, 0-10 single-ended, 0-4 differential
+Info:
+    Writing ADC2MUX restarts ADC2, a running ADC2 keeps converting.
+    Return 0 success, 1 channel out of range
+******************************************************************************/
+UBYTE ADS1263_SelectChannal_ADC2(ADS1263_DEVICE *Dev, UBYTE Channel)
+{
+    if(Dev->ScanMode == 0) {
+        if(Channel>10) {
+            return 1;
+        }
+        ADS1263_SetChannal_ADC2(Dev, Channel);
+    } else {
+        if(Channel>4) {
+            return 1;
+        }
+        ADS1263_SetDiffChannal_ADC2(Dev, Channel);
+    }
+    return 0;
+}
+
+/******************************************************************************
+function:  Set the ADC2 channels cycled by ADS1263_ReadDual
+parameter: 
+    List   : ADC2 channels, as for ADS1263_GetAll
+    Number : list length, 0 leaves ADC2 on its current input
+Info:
+    Selects List[0]; after each ADC2 result the next entry is selected.
+    Return 0 success, 1 bad list
+******************************************************************************/
+UBYTE ADS1263_SetDualList(ADS1263_DEVICE *Dev, const UBYTE *List, UBYTE Number)
+{
+    UBYTE i;
+    if(Number > sizeof(Dev->DualList)) {
+        return 1;
+    }
+    for(i = 0; i < Number; i++) {
+        if(List[i] > (Dev->ScanMode == 0 ? 10 : 4)) {
+            return 1;
+        }
+        Dev->DualList[i] = List[i];
+    }
+    Dev->DualNumber = Number;
+    Dev->DualIndex = 0;
+    if(Number != 0) {
+        ADS1263_SelectChannal_ADC2(Dev, Dev->DualList[0]);
+    }
+    return 0;
+}
+
+/******************************************************************************
+function:  Read ADC1 and, when it has a new result, ADC2
+parameter: 
+    ADC1 : receives the ADC1 conversion
+    ADC2 : receives the ADC2 conversion, untouched if there is none
+Info:
+    Paced by ADC1: DRDY only follows ADC1, and the ADC2 new-data bit
+    comes in the status byte of the RDATA1 frame, so only then is an
+    RDATA2 frame sent. ADC2 results take ADC1's timestamp, i.e. the time
+    they were noticed; run ADC1 faster than ADC2 or some are missed.
+    ADC1->Channel is left to the caller, ADC2->Channel is set.
+    Return 0 DRDY timeout, else ADS1263_DUAL_ADC1 | ADS1263_DUAL_ADC2
+******************************************************************************/
+UBYTE ADS1263_ReadDual(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *ADC1, ADS1263_SAMPLE *ADC2)
+{
+    if(ADS1263_WaitSample(Dev, ADC1) != 0 || ADS1263_Read_ADC1_Frame(Dev, ADC1) != 0) {
+        return 0;
+    }
+    if((ADC1->Status & 0x80) == 0) {
+        return ADS1263_DUAL_ADC1;
+    }
+
+    if(ADS1263_Read_ADC2_Frame(Dev, ADC2) != 0) {
+        return ADS1263_DUAL_ADC1;
+    }
+    ADC2->Time_ns = ADC1->Time_ns;
+    ADC2->Channel = Dev->ADC2Channel;
+    if(Dev->DualNumber > 1) {
+        if(++Dev->DualIndex >= Dev->DualNumber)
+            Dev->DualIndex = 0;
+        ADS1263_SelectChannal_ADC2(Dev, Dev->DualList[Dev->DualIndex]);
+    }
+    return ADS1263_DUAL_ADC1 | ADS1263_DUAL_ADC2;
+}
+
+/******************************************************************************
+function:  Wait for the next ADC1 conversion and read it
+parameter: 
+    Sample : receives code, status, CRC, flags and the DRDY timestamp
+Info:
+    Reads whatever input is selected; Channel is left to the caller.
+    Return 0 success, 1 DRDY timeout or no new data
+******************************************************************************/
+UBYTE ADS1263_ReadSample(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample)
+{
+    if(ADS1263_WaitSample(Dev, Sample) != 0) {
+        return 1;
+    }
+    return ADS1263_Read_ADC1_Frame(Dev, Sample);
+}
+
+/******************************************************************************
+function:  Wait for the next ADC1 conversion without reading it
+parameter: 
+    Sample : receives the DRDY timestamp, or a timeout
+Info:
+    Split from ADS1263_ReadSample so a scan can reprogram the mux between
+    DRDY and the readout; finish with ADS1263_ReadFrame.
+    Return 0 success, 1 DRDY timeout
+******************************************************************************/
+UBYTE ADS1263_WaitSample(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample)
+{
+    struct timespec ts;
+    if(ADS1263_WaitDRDY(Dev) != 0) {
+        Sample->Value = 0;
+        Sample->Status = Sample->CRC = 0;
+        Sample->Flags = ADS1263_SAMPLE_TIMEOUT;
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    Sample->Time_ns = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    return 0;
+}
+
+/******************************************************************************
+function:  Read the latched ADC1 conversion
+parameter: 
+    Sample : receives code, status, CRC and flags
+Info:
+    Return 0 success, 1 no new data (ADS1263_SAMPLE_TIMEOUT)
+******************************************************************************/
+UBYTE ADS1263_ReadFrame(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample)
+{
+    return ADS1263_Read_ADC1_Frame(Dev, Sample);
+}
+
+/******************************************************************************
+function:  Start an empty bus transaction
+parameter: 
+Info:
+******************************************************************************/
+void ADS1263_Chain_Init(ADS1263_CHAIN *Chain)
+{
+    Chain->Number = 0;
+    Chain->Sample = NULL;
+}
+
+/******************************************************************************
+function:  Queue a register frame
+parameter: 
+        Frame : CMD_WREG | first register, count - 1, data bytes
+        Len   : frame length, up to ADS1263_CHAIN_FRAME
+Info:
+    Frame is copied, as for ADS1263_WriteRegFrame.
+    Return 0 success, 1 chain full or frame too long
+******************************************************************************/
+UBYTE ADS1263_Chain_WriteRegFrame(ADS1263_CHAIN *Chain, const UBYTE *Frame, UBYTE Len)
+{
+    if(Chain->Number >= ADS1263_CHAIN_MAX || Len < 3 || Len > ADS1263_CHAIN_FRAME) {
+        return 1;
+    }
+    memcpy(Chain->Buf[Chain->Number], Frame, Len);
+    Chain->Xfer[Chain->Number].Buf = Chain->Buf[Chain->Number];
+    Chain->Xfer[Chain->Number].Len = Len;
+    Chain->Number++;
+    return 0;
+}
+
+/******************************************************************************
+function:  Queue the readout of the latched ADC1 conversion
+parameter: 
+    Sample : receives code, status, CRC and flags after ADS1263_Chain_Run
+Info:   Return 0 success, 1 chain full or already reading
+******************************************************************************/
+UBYTE ADS1263_Chain_ReadFrame(ADS1263_CHAIN *Chain, ADS1263_SAMPLE *Sample)
+{
+    UBYTE *buf;
+    if(Chain->Number >= ADS1263_CHAIN_MAX || Chain->Sample != NULL) {
+        return 1;
+    }
+    buf = Chain->Buf[Chain->Number];
+    memset(buf, 0, ADS1263_DATA_FRAME);
+    buf[0] = CMD_RDATA1;
+    Chain->Xfer[Chain->Number].Buf = buf;
+    Chain->Xfer[Chain->Number].Len = ADS1263_DATA_FRAME;
+    Chain->Read = Chain->Number++;
+    Chain->Sample = Sample;
+    return 0;
+}
+
+/******************************************************************************
+function:  Send the queued frames in one chip-select window
+parameter: 
+    Chain : queued frames, emptied afterwards
+Info:
+    The chip decodes commands back to back, so frames need no CS edge
+    between them; on spidev the window is one SPI_IOC_MESSAGE(N).
+    The shadow takes the written bytes before they are overwritten by
+    what comes back. A readout alone is sent as ADS1263_ReadFrame would,
+    retries included. Next to register frames it is not retried: the mux
+    has moved on, and a re-read would return the next input's conversion.
+    Without new ADC1 data the sample is flagged ADS1263_SAMPLE_TIMEOUT.
+******************************************************************************/
+void ADS1263_Chain_Run(ADS1263_DEVICE *Dev, ADS1263_CHAIN *Chain)
+{
+    UBYTE i, Verify = 0;
+    uint64_t t0;
+
+    if(Chain->Number == 0) {
+        return;
+    }
+    if(Chain->Number == 1 && Chain->Sample != NULL) {
+        ADS1263_Read_ADC1_Frame(Dev, Chain->Sample);
+        ADS1263_Chain_Init(Chain);
+        return;
+    }
+    for(i = 0; i < Chain->Number; i++) {
+        if(Chain->Sample == NULL || i != Chain->Read)
+            Verify |= ADS1263_ShadowFrame(Dev, Chain->Buf[i], Chain->Xfer[i].Len);
+    }
+    t0 = ADS1263_Stats_Begin(Dev);
+    ADS1263_Select(Dev);
+    DEV_Port_Transfer_Chain(Dev->Port, Chain->Xfer, Chain->Number);
+    ADS1263_Deselect(Dev);
+    ADS1263_Stats_End(Dev, Chain->Sample != NULL ? ADS1263_STAGE_READ : ADS1263_STAGE_MUX, t0);
+
+    if(Chain->Sample != NULL) {
+        if((Chain->Buf[Chain->Read][1] & 0x40) == 0)
+            ADS1263_Read_Timeout(Dev, Chain->Sample);
+        else
+            ADS1263_Decode_ADC1(Dev, Chain->Buf[Chain->Read], Chain->Sample);
+    }
+    if(Verify) {
+        ADS1263_VerifyReg(Dev, REG_INPMUX, "ADS1263_Chain_Run");
+    }
+    ADS1263_Chain_Init(Chain);
+}
+
+/******************************************************************************
+function:  Filter settling latency of ADC1
+parameter: 
+    Rate   : data rate
+    Filter : digital filter
+Info:
+    Time from a conversion restart (START1, a mux or register write) to
+    the first settled result, MODE0 delay and chop not included. A sinc
+    filter of order n needs n data periods; the FIR filter settles in one
+    at its 2.5 to 20 SPS and is given the same above them, as a lower
+    bound. The chip holds DRDY until that result, so none is thrown away.
+    Return us, rounded down
+******************************************************************************/
+UDOUBLE ADS1263_GetLatency_us(ADS1263_DRATE Rate, ADS1263_FILTER Filter)
+{
+    static const UDOUBLE Latency_us[16][5] = {
+        // SINC1    SINC2     SINC3     SINC4     FIR
+        { 400000,  800000, 1200000, 1600000,  400000},  // 2.5 SPS
+        { 200000,  400000,  600000,  800000,  200000},  // 5
+        { 100000,  200000,  300000,  400000,  100000},  // 10
+        {  60240,  120481,  180722,  240963,   60240},  // 16.6
+        {  50000,  100000,  150000,  200000,   50000},  // 20
+        {  20000,   40000,   60000,   80000,   20000},  // 50
+        {  16666,   33333,   50000,   66666,   16666},  // 60
+        {  10000,   20000,   30000,   40000,   10000},  // 100
+        {   2500,    5000,    7500,   10000,    2500},  // 400
+        {    833,    1666,    2500,    3333,     833},  // 1200
+        {    416,     833,    1250,    1666,     416},  // 2400
+        {    208,     416,     625,     833,     208},  // 4800
+        {    138,     277,     416,     555,     138},  // 7200
+        {     69,     138,     208,     277,      69},  // 14400
+        {     52,     104,     156,     208,      52},  // 19200
+        {     26,      52,      78,     104,      26},  // 38400
+    };
+    if(Rate > ADS1263_38400SPS || Filter > ADS1263_FIR) {
+        return 0;
+    }
+    return Latency_us[Rate][Filter];
+}
+
+/******************************************************************************
+function:  Shortest time from a conversion restart to the next DRDY
+parameter: 
+Info:
+    Programmed MODE0 delay plus the filter latency at the MODE2 rate and
+    MODE1 filter, taken from the register shadow; chop runs two
+    conversions per result and doubles the latency.
+    A lower bound the scan scheduler builds its pipeline window on.
+******************************************************************************/
+UDOUBLE ADS1263_GetSettle_us(ADS1263_DEVICE *Dev)
+{
+    // ADS1263_DELAY in us, rounded down
+    static const UDOUBLE Delay_us[16] = {
+        0, 8, 17, 35, 69, 139, 278, 555, 1100, 2200, 4400, 8800,
+    };
+    UBYTE MODE0 = ADS1263_GetReg(Dev, REG_MODE0);
+    UBYTE Filter = ADS1263_GetReg(Dev, REG_MODE1) >> 5;
+    UDOUBLE Latency;
+
+    Latency = ADS1263_GetLatency_us(ADS1263_GetReg(Dev, REG_MODE2) & 0x0f, Filter > ADS1263_FIR ? ADS1263_FIR : Filter);
+    if(MODE0 & 0x10) {
+        Latency *= 2;
+    }
+    return Delay_us[MODE0 & 0x0f] + Latency;
+}
+
 /******************************************************************************
 function:  Read data from all channels
 parameter: 
     ADC_Value : ADC Value
 Info:
 ******************************************************************************/
-void ADS1263_GetAll(UBYTE *List, UDOUBLE *Value, int Number)
+void ADS1263_GetAll(ADS1263_DEVICE *Dev, UBYTE *List, UDOUBLE *Value, int Number)
 {
-    UBYTE i;
+    ADS1263_SCAN_ENTRY Entry[ADS1263_SCAN_MAXSTEP];
+    int i;
+
+    // compile the list once and rerun the plan while list and mode stay the same
+    if(Number > 0 && Number <= ADS1263_SCAN_MAXSTEP) {
+        if(Dev->PlanMode != Dev->ScanMode || Dev->Plan.Number != Number || memcmp(Dev->PlanList, List, Number) != 0) {
+            for(i = 0; i < Number; i++) {
+                Entry[i].Type = Dev->ScanMode == 0 ? ADS1263_SCAN_SINGLE : ADS1263_SCAN_DIFF;
+                Entry[i].Channel = List[i];
+            }
+            Dev->PlanMode = 0xff;
+            if(ADS1263_ScanPlan_Build(Dev, &Dev->Plan, Entry, Number) == 0) {
+                memcpy(Dev->PlanList, List, Number);
+                Dev->PlanMode = Dev->ScanMode;
+            }
+        }
+        if(Dev->PlanMode == Dev->ScanMode) {
+            ADS1263_ScanPlan_Run(Dev, &Dev->Plan, Value);
+            return;
+        }
+    }
+
     for(i = 0; i<Number; i++) {
-         Value[i] = ADS1263_GetChannalValue(List[i]);
+         Value[i] = ADS1263_GetChannalValue(Dev, List[i]);
         // ADS1263_WriteCmd(CMD_STOP1);
         // DEV_Delay_ms(20);
     }
@@ -519,12 +1592,12 @@ parameter:
     ADC_Value : ADC Value
 Info:
 ******************************************************************************/
-void ADS1263_GetAll_ADC2(UDOUBLE *ADC_Value)
+void ADS1263_GetAll_ADC2(ADS1263_DEVICE *Dev, UDOUBLE *ADC_Value)
 {
     UBYTE i;
     for(i = 0; i<10; i++) {
-        ADC_Value[i] = ADS1263_GetChannalValue_ADC2(i);
-        ADS1263_WriteCmd(CMD_STOP2);
+        ADC_Value[i] = ADS1263_GetChannalValue_ADC2(Dev, i);
+        ADS1263_WriteCmd(Dev, CMD_STOP2);
         // DEV_Delay_ms(20);
     }
     // printf("----------Read ADC2 value success----------\r\n");
@@ -538,45 +1611,43 @@ parameter:
     drate : speed
 Info:
 ******************************************************************************/
-UDOUBLE ADS1263_RTD(ADS1263_DELAY delay, ADS1263_GAIN gain, ADS1263_DRATE drate)
+UDOUBLE ADS1263_RTD(ADS1263_DEVICE *Dev, ADS1263_DELAY delay, ADS1263_GAIN gain, ADS1263_DRATE drate)
 {
     UDOUBLE Value;
 
+    // registers take effect as they are written, the IDAC settles in the MODE0 delay
     //MODE0 (CHOP OFF)
     UBYTE MODE0 = delay;
-    ADS1263_WriteReg(REG_MODE0, MODE0);
-    DEV_Delay_ms(1);
+    ADS1263_WriteReg(Dev, REG_MODE0, MODE0);
     
     //(IDACMUX) IDAC2 AINCOM,IDAC1 AIN3
     UBYTE IDACMUX = (0x0a<<4) | 0x03;
-    ADS1263_WriteReg(REG_IDACMUX, IDACMUX);
-    DEV_Delay_ms(1);
+    ADS1263_WriteReg(Dev, REG_IDACMUX, IDACMUX);
     
     //((IDACMAG)) IDAC2 = IDAC1 = 250uA
     UBYTE IDACMAG = (0x03<<4) | 0x03;
-    ADS1263_WriteReg(REG_IDACMAG, IDACMAG);
-    DEV_Delay_ms(1);
+    ADS1263_WriteReg(Dev, REG_IDACMAG, IDACMAG);
     
     UBYTE MODE2 = (gain << 4) | drate;
-    ADS1263_WriteReg(REG_MODE2, MODE2);
-    DEV_Delay_ms(1);
+    ADS1263_WriteReg(Dev, REG_MODE2, MODE2);
     
     //INPMUX (AINP = AIN7, AINN = AIN6)
     UBYTE INPMUX = (0x07<<4) | 0x06;
-    ADS1263_WriteReg(REG_INPMUX, INPMUX);
-    DEV_Delay_ms(1);
+    ADS1263_WriteReg(Dev, REG_INPMUX, INPMUX);
     
     // REFMUX AIN4 AIN5
     UBYTE REFMUX = (0x03<<3) | 0x03;
-    ADS1263_WriteReg(REG_REFMUX, REFMUX);
-    DEV_Delay_ms(1);
+    ADS1263_WriteReg(Dev, REG_REFMUX, REFMUX);
     
     //Read one conversion
-    ADS1263_WriteCmd(CMD_START1);
-    DEV_Delay_ms(10);
-    ADS1263_WaitDRDY();
-    Value = ADS1263_Read_ADC1_Data();
-    ADS1263_WriteCmd(CMD_STOP1);
+    ADS1263_WriteCmd(Dev, CMD_START1);
+    DEV_Delay_us(ADS1263_START_US);
+    if(ADS1263_WaitDRDY(Dev) != 0) {
+        ADS1263_WriteCmd(Dev, CMD_STOP1);
+        return 0;
+    }
+    Value = ADS1263_Read_ADC1_Data(Dev);
+    ADS1263_WriteCmd(Dev, CMD_STOP1);
 
     return Value;
 }
@@ -589,7 +1660,7 @@ parameter:
     isOpen :        open or close
 Info:
 ******************************************************************************/
-void ADS1263_DAC(ADS1263_DAC_VOLT volt, UBYTE isPositive, UBYTE isOpen)
+void ADS1263_DAC(ADS1263_DEVICE *Dev, ADS1263_DAC_VOLT volt, UBYTE isPositive, UBYTE isOpen)
 {
     UBYTE Reg, Value;
     
@@ -603,6 +1674,6 @@ void ADS1263_DAC(ADS1263_DAC_VOLT volt, UBYTE isPositive, UBYTE isOpen)
     else 
         Value = 0x00;
     
-    ADS1263_WriteReg(Reg, Value);
+    ADS1263_WriteReg(Dev, Reg, Value);
 }
 
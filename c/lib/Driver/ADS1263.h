@@ -30,7 +30,9 @@
 #ifndef _ADS1263_H_
 #define _ADS1263_H_
 
+#include <stdatomic.h>
 #include "DEV_Config.h"
+#include "ADS1263_Stats.h"
 
 #define Positive_A6 1
 #define Negative_A7 0
@@ -86,6 +88,25 @@ typedef enum
     ADS1263_DELAY_8d8ms,
 }ADS1263_DELAY;
 
+/* ADC1 digital filter, REG_MODE1 bits 7:5 */
+typedef enum
+{
+    ADS1263_SINC1   = 0,
+    ADS1263_SINC2,
+    ADS1263_SINC3,
+    ADS1263_SINC4,
+    ADS1263_FIR,            // 2.5 to 20 SPS only
+}ADS1263_FILTER;
+
+/* ADC1 chop and IDAC rotation, REG_MODE0 bits 5:4 */
+typedef enum
+{
+    ADS1263_CHOP_OFF    = 0,
+    ADS1263_CHOP_INPUT,     // input chop, halves the data rate
+    ADS1263_CHOP_IDAC,      // IDAC rotation
+    ADS1263_CHOP_BOTH,
+}ADS1263_CHOP;
+
 typedef enum
 {
     ADS1263_ADC2_10SPS  =   0,
@@ -161,6 +182,8 @@ typedef enum
     REG_ADC2FSC1,   // 40h
 }ADS1263_REG;
 
+#define ADS1263_REG_NUM     (REG_ADC2FSC1 + 1)
+
 typedef enum
 {
     CMD_RESET   = 0x06, // Reset the ADC, 0000 011x (06h or 07h)
@@ -182,12 +205,199 @@ typedef enum
     CMD_WREG2   = 0x00, // number of registers to write minus 1, 000n nnnn
 }ADS1263_CMD;
 
-UBYTE ADS1263_init_ADC1(ADS1263_DRATE rate);
-UBYTE ADS1263_init_ADC2(ADS1263_ADC2_DRATE rate);
-void ADS1263_SetMode(UBYTE Mode);
-UDOUBLE ADS1263_GetChannalValue(UBYTE Channel);
-void ADS1263_GetAll(UBYTE *List, UDOUBLE *Value, int Number);
-void ADS1263_GetAll_ADC2(UDOUBLE *ADC_Value);
-UDOUBLE ADS1263_RTD(ADS1263_DELAY delay, ADS1263_GAIN gain, ADS1263_DRATE drate);
-void ADS1263_DAC(ADS1263_DAC_VOLT volt, UBYTE isPositive, UBYTE isClose);
+/* REG_INTERFACE CRC bits, how data frames are checked */
+typedef enum
+{
+    ADS1263_CRC_OFF = 0,        // no check byte
+    ADS1263_CRC_CHECKSUM,       // byte sum + 9Bh (default)
+    ADS1263_CRC_CRC8,           // CRC-8, x^8 + x^2 + x + 1
+}ADS1263_CRC_MODE;
+
+/* CRC-8 preset */
+#define ADS1263_CRC8_INIT       0xff
+
+/* ADS1263_SAMPLE.Flags */
+#define ADS1263_SAMPLE_CRC_ERR  0x01    // checksum mismatch
+#define ADS1263_SAMPLE_TIMEOUT  0x02    // DRDY never came, Value is 0
+#define ADS1263_SAMPLE_LATE     0x04    // pipelined readout overran the next conversion
+
+/* ADS1263_ReadDual return */
+#define ADS1263_DUAL_ADC1       0x01    // ADC1 sample read
+#define ADS1263_DUAL_ADC2       0x02    // ADC2 sample read as well
+
+/**
+ * One ADC conversion as read off the bus
+**/
+typedef struct {
+    uint64_t Time_ns;   // CLOCK_MONOTONIC_RAW when DRDY was seen low
+    UDOUBLE Value;      // raw code, ADC1 32-bit / ADC2 24-bit
+    UBYTE Channel;      // channel number as passed to the driver
+    UBYTE Status;       // status byte sent ahead of the data
+    UBYTE CRC;          // checksum byte sent after the data
+    UBYTE Flags;        // ADS1263_SAMPLE_xxx
+} ADS1263_SAMPLE;
+
+/**
+ * Scan plans, see ADS1263_Scan.h
+**/
+#define ADS1263_SCAN_MAXSTEP    32
+
+/* ADS1263_SCAN_ENTRY.Type */
+typedef enum
+{
+    ADS1263_SCAN_SINGLE = 0,    // Channel vs AINCOM, 0-10
+    ADS1263_SCAN_DIFF,          // pair as ADS1263_SetDiffChannal, 0-4
+    ADS1263_SCAN_MUX,           // any INPMUX code: Channel positive, Negative negative
+    ADS1263_SCAN_RTD,           // as MUX, plus IDAC excitation and reference
+}ADS1263_SCAN_TYPE;
+
+/**
+ * One entry of the channel list a plan is built from
+**/
+typedef struct {
+    UBYTE Type;         // ADS1263_SCAN_TYPE
+    UBYTE Channel;      // SINGLE/DIFF channel, MUX/RTD positive input 0-15
+    UBYTE Negative;     // MUX/RTD negative input 0-15
+    UBYTE IDACMUX;      // RTD only: REG_IDACMUX value
+    UBYTE IDACMAG;      // RTD only: REG_IDACMAG value
+    UBYTE REFMUX;       // RTD only: REG_REFMUX value
+} ADS1263_SCAN_ENTRY;
+
+/**
+ * Precomputed step: frames are ready to go out on the bus as they are
+**/
+typedef struct {
+    UBYTE MuxFrame[3];  // WREG INPMUX
+    UBYTE ExcFrame[5];  // WREG IDACMUX, IDACMAG, REFMUX
+    UBYTE WriteMux;     // INPMUX differs from the previous step
+    UBYTE WriteExc;     // IDAC/reference differ from the previous step
+    UBYTE Channel;      // reported in ADS1263_SAMPLE.Channel
+} ADS1263_SCAN_STEP;
+
+typedef struct {
+    ADS1263_SCAN_STEP Step[ADS1263_SCAN_MAXSTEP];
+    UBYTE Number;
+    UBYTE UseExc;       // some step needs IDAC/reference changes
+} ADS1263_SCAN_PLAN;
+
+/**
+ * ADC1 set-up written by ADS1263_ConfigureADC1
+**/
+typedef struct {
+    ADS1263_DRATE Rate;
+    ADS1263_FILTER Filter;
+    ADS1263_GAIN Gain;
+    UBYTE Bypass;           // 1 PGA bypassed, Gain ignored by the chip
+    ADS1263_CHOP Chop;
+    ADS1263_DELAY Delay;    // conversion start delay after a restart
+    UBYTE RefMux;           // REG_REFMUX, 0x24 AVDD/AVSS, 0x00 internal 2.5V
+    UBYTE SensorBias;       // REG_MODE1 bits 4:0, SBADC/SBPOL/SBMAG
+} ADS1263_ADC1_CONFIG;
+
+/**
+ * Frames queued to go out under one chip select, see ADS1263_Chain_Run
+**/
+#define ADS1263_CHAIN_MAX       4
+#define ADS1263_CHAIN_FRAME     8       // longest frame a chain carries
+
+typedef struct {
+    DEV_SPI_XFER Xfer[ADS1263_CHAIN_MAX];
+    UBYTE Buf[ADS1263_CHAIN_MAX][ADS1263_CHAIN_FRAME];
+    ADS1263_SAMPLE *Sample;             // fed by the RDATA1 transfer, NULL none queued
+    UBYTE Read;                         // index of the RDATA1 transfer
+    UBYTE Number;
+} ADS1263_CHAIN;
+
+/**
+ * Error counts since ADS1263_Device_Init, see ADS1263_GetErrors
+**/
+typedef struct {
+    UDOUBLE Crc;        // ADC1 and ADC2 data frames with a checksum mismatch
+    UDOUBLE Timeout;    // DRDY waits that timed out
+    UDOUBLE Verify;     // mux read-backs that differed from the shadow
+    UDOUBLE Config;     // configuration registers that did not read back
+} ADS1263_ERRORS;
+
+/**
+ * One ADS1263: the board it sits on and what the driver knows about the
+ * chip. Nothing is shared between devices, so boards on different ports
+ * can be driven side by side from one process.
+**/
+typedef struct {
+    DEV_PORT *Port;
+
+    UBYTE ScanMode;                         // 0 single-ended, 1 differential, see ADS1263_SetMode
+
+    UBYTE Shadow[ADS1263_REG_NUM];          // register shadow: last value written to or read from each register
+    UDOUBLE ShadowValid;                    // bit n set: Shadow[n] is known
+    UDOUBLE VerifyPeriod;                   // 0: no mux read-back, N: every Nth select
+    UDOUBLE VerifyCount;
+    UBYTE FastStart;                        // see ADS1263_SetFastStart
+    UBYTE CrcMode;                          // ADS1263_CRC_MODE the chip is set to
+    UBYTE CrcDefer;                         // see ADS1263_SetCrcDefer
+
+    UBYTE DualList[11];                     // ADC2 side of dual acquisition, see ADS1263_SetDualList
+    UBYTE DualNumber;
+    UBYTE DualIndex;
+    UBYTE ADC2Channel;                      // input ADC2MUX selects
+
+    UBYTE Pipeline;                         // see ADS1263_ScanPlan_SetPipeline
+    uint64_t Readout_ns;                    // last pipelined mux write + readout time
+
+    ADS1263_SCAN_PLAN Plan;                 // ADS1263_GetAll plan cache
+    UBYTE PlanList[ADS1263_SCAN_MAXSTEP];
+    UBYTE PlanMode;                         // ScanMode Plan was built for, 0xff none
+
+    atomic_uint ErrCrc;                     // see ADS1263_ERRORS, may be read from any thread
+    atomic_uint ErrTimeout;
+    atomic_uint ErrVerify;
+    atomic_uint ErrConfig;
+
+    ADS1263_STATS *Stats;                   // see ADS1263_SetStats, NULL none
+} ADS1263_DEVICE;
+
+void ADS1263_Device_Init(ADS1263_DEVICE *Dev, DEV_PORT *Port);
+
+void ADS1263_WriteCmd(ADS1263_DEVICE *Dev, UBYTE Cmd);
+void ADS1263_WriteReg(ADS1263_DEVICE *Dev, UBYTE Reg, UBYTE data);
+UBYTE ADS1263_Read_data(ADS1263_DEVICE *Dev, UBYTE Reg);
+UBYTE ADS1263_GetReg(ADS1263_DEVICE *Dev, UBYTE Reg);
+UBYTE ADS1263_ReadRegs(ADS1263_DEVICE *Dev, UBYTE First, UBYTE Count, UBYTE *Data);
+void ADS1263_ReadAllRegs(ADS1263_DEVICE *Dev, UBYTE *Data);
+void ADS1263_WriteRegFrame(ADS1263_DEVICE *Dev, const UBYTE *Frame, UBYTE Len);
+void ADS1263_ShadowInvalidate(ADS1263_DEVICE *Dev, UBYTE First, UBYTE Count);
+void ADS1263_SetVerify(ADS1263_DEVICE *Dev, UDOUBLE Period);
+void ADS1263_SetFastStart(ADS1263_DEVICE *Dev, UBYTE Enable);
+void ADS1263_GetErrors(ADS1263_DEVICE *Dev, ADS1263_ERRORS *Err, UBYTE Clear);
+void ADS1263_SetStats(ADS1263_DEVICE *Dev, ADS1263_STATS *Stats);
+UBYTE ADS1263_SetCrcMode(ADS1263_DEVICE *Dev, ADS1263_CRC_MODE Mode);
+void ADS1263_SetCrcDefer(ADS1263_DEVICE *Dev, UBYTE Enable);
+UDOUBLE ADS1263_CheckBlock(ADS1263_DEVICE *Dev, const ADS1263_SAMPLE *Sample, UDOUBLE Number, UDOUBLE *Bad);
+
+UBYTE ADS1263_init_ADC1(ADS1263_DEVICE *Dev, ADS1263_DRATE rate);
+UBYTE ADS1263_init_ADC1_Config(ADS1263_DEVICE *Dev, const ADS1263_ADC1_CONFIG *Config);
+void ADS1263_ADC1_DefaultConfig(ADS1263_ADC1_CONFIG *Config, ADS1263_DRATE Rate);
+UBYTE ADS1263_ConfigureADC1(ADS1263_DEVICE *Dev, const ADS1263_ADC1_CONFIG *Config);
+UDOUBLE ADS1263_GetLatency_us(ADS1263_DRATE Rate, ADS1263_FILTER Filter);
+UBYTE ADS1263_Calibrate(ADS1263_DEVICE *Dev, UBYTE Cmd);
+UBYTE ADS1263_init_ADC2(ADS1263_DEVICE *Dev, ADS1263_ADC2_DRATE rate);
+UBYTE ADS1263_init_Dual(ADS1263_DEVICE *Dev, ADS1263_DRATE rate1, ADS1263_ADC2_DRATE rate2);
+void ADS1263_SetMode(ADS1263_DEVICE *Dev, UBYTE Mode);
+UDOUBLE ADS1263_GetChannalValue(ADS1263_DEVICE *Dev, UBYTE Channel);
+UBYTE ADS1263_SelectChannal(ADS1263_DEVICE *Dev, UBYTE Channel);
+UBYTE ADS1263_ReadSample(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample);
+UBYTE ADS1263_WaitSample(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample);
+UBYTE ADS1263_ReadFrame(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *Sample);
+void ADS1263_Chain_Init(ADS1263_CHAIN *Chain);
+UBYTE ADS1263_Chain_WriteRegFrame(ADS1263_CHAIN *Chain, const UBYTE *Frame, UBYTE Len);
+UBYTE ADS1263_Chain_ReadFrame(ADS1263_CHAIN *Chain, ADS1263_SAMPLE *Sample);
+void ADS1263_Chain_Run(ADS1263_DEVICE *Dev, ADS1263_CHAIN *Chain);
+UDOUBLE ADS1263_GetSettle_us(ADS1263_DEVICE *Dev);
+UBYTE ADS1263_SelectChannal_ADC2(ADS1263_DEVICE *Dev, UBYTE Channel);
+UBYTE ADS1263_SetDualList(ADS1263_DEVICE *Dev, const UBYTE *List, UBYTE Number);
+UBYTE ADS1263_ReadDual(ADS1263_DEVICE *Dev, ADS1263_SAMPLE *ADC1, ADS1263_SAMPLE *ADC2);
+void ADS1263_GetAll(ADS1263_DEVICE *Dev, UBYTE *List, UDOUBLE *Value, int Number);
+void ADS1263_GetAll_ADC2(ADS1263_DEVICE *Dev, UDOUBLE *ADC_Value);
+UDOUBLE ADS1263_RTD(ADS1263_DEVICE *Dev, ADS1263_DELAY delay, ADS1263_GAIN gain, ADS1263_DRATE drate);
+void ADS1263_DAC(ADS1263_DEVICE *Dev, ADS1263_DAC_VOLT volt, UBYTE isPositive, UBYTE isClose);
 #endif
\ No newline at end of file
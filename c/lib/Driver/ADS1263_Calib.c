@@ -0,0 +1,275 @@
+/*****************************************************************************
+* | File        :   ADS1263_Calib.c
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 calibration coefficients per gain and data rate
+* | Info        :
+*   Self/system calibration, kept in a small file and written back
+*   to OFCAL/FSCAL in one burst
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "ADS1263_Calib.h"
+#include <stdio.h>
+#include <errno.h>
+
+_Static_assert(sizeof(ADS1263_CALIB_ENTRY) == 8, "calibration entry is 8 bytes");
+_Static_assert(sizeof(ADS1263_CALIB_HEADER) == 16, "calibration header is 16 bytes");
+
+/* OFCAL0 to FSCAL2 after a reset: no offset, gain 1 */
+static const UBYTE ADS1263_Calib_Default[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x40};
+
+/******************************************************************************
+function:   Entry for a REG_MODE2 value
+parameter:
+Info:   Return the entry, NULL none
+******************************************************************************/
+static ADS1263_CALIB_ENTRY *ADS1263_Calib_Find(const ADS1263_CALIB *Cal, UBYTE Mode2)
+{
+    UWORD i;
+    for(i = 0; i < Cal->Number; i++) {
+        if(Cal->Entry[i].Mode2 == Mode2)
+            return (ADS1263_CALIB_ENTRY *)&Cal->Entry[i];
+    }
+    return NULL;
+}
+
+/******************************************************************************
+function:   Write OFCAL0 to FSCAL2 in one WREG
+parameter:
+    Coef : OFCAL0..2, FSCAL0..2
+Info:
+******************************************************************************/
+static void ADS1263_Calib_Write(ADS1263_DEVICE *Dev, const UBYTE *Coef)
+{
+    UBYTE Frame[8] = {CMD_WREG | REG_OFCAL0, CMD_WREG2 | 5};
+    memcpy(&Frame[2], Coef, 6);
+    ADS1263_WriteRegFrame(Dev, Frame, sizeof(Frame));
+}
+
+/******************************************************************************
+function:   Byte sum of the entries, for the file header
+parameter:
+Info:
+******************************************************************************/
+static UDOUBLE ADS1263_Calib_Sum(const ADS1263_CALIB *Cal)
+{
+    const UBYTE *p = (const UBYTE *)Cal->Entry;
+    UDOUBLE Sum = 0, i;
+    for(i = 0; i < Cal->Number * sizeof(ADS1263_CALIB_ENTRY); i++)
+        Sum += p[i];
+    return Sum;
+}
+
+/******************************************************************************
+function:   Empty table
+parameter:
+Info:
+******************************************************************************/
+void ADS1263_Calib_Init(ADS1263_CALIB *Cal)
+{
+    memset(Cal, 0, sizeof(*Cal));
+}
+
+/******************************************************************************
+function:   Calibrate the current gain and data rate
+parameter:
+    Cal : table, the entry for the current REG_MODE2 is added or updated
+    Cmd : CMD_SFOCAL1, CMD_SYOCAL1 or CMD_SYGCAL1, see ADS1263_Calibrate
+Info:
+    ADC1 must be converting. The chip starts from the coefficients already
+    held for this set-up, or from the reset values, so an offset and
+    a gain calibration of the same set-up build on each other.
+    Return 0 success, 1 table full or calibration failed
+******************************************************************************/
+UBYTE ADS1263_Calib_Run(ADS1263_DEVICE *Dev, ADS1263_CALIB *Cal, UBYTE Cmd)
+{
+    UBYTE Mode2 = ADS1263_GetReg(Dev, REG_MODE2);
+    ADS1263_CALIB_ENTRY *Entry = ADS1263_Calib_Find(Cal, Mode2);
+    UBYTE Coef[6], i;
+
+    if(Entry == NULL) {
+        if(Cal->Number >= ADS1263_CALIB_MAX) {
+            Log_Error("ADS1263_Calib_Run: table full \r\n");
+            return 1;
+        }
+        Entry = &Cal->Entry[Cal->Number++];
+        Entry->Mode2 = Mode2;
+        Entry->Flags = 0;
+        memcpy(Entry->OFCAL, ADS1263_Calib_Default, 3);
+        memcpy(Entry->FSCAL, ADS1263_Calib_Default + 3, 3);
+    }
+    memcpy(Coef, Entry->OFCAL, 3);
+    memcpy(Coef + 3, Entry->FSCAL, 3);
+    ADS1263_Calib_Write(Dev, Coef);
+
+    if(ADS1263_Calibrate(Dev, Cmd) != 0) {
+        return 1;
+    }
+    // ADS1263_Calibrate left the results in the shadow
+    for(i = 0; i < 3; i++) {
+        Entry->OFCAL[i] = ADS1263_GetReg(Dev, REG_OFCAL0 + i);
+        Entry->FSCAL[i] = ADS1263_GetReg(Dev, REG_FSCAL0 + i);
+    }
+    Entry->Flags |= (Cmd == CMD_SYGCAL1) ? ADS1263_CALIB_GAIN : ADS1263_CALIB_OFFSET;
+    return 0;
+}
+
+/******************************************************************************
+function:   Self offset calibration of every gain and data rate combination
+parameter:
+    Cal        : table the results go into
+    Base       : filter, chop, delay and reference used throughout
+    Gain       : gains to calibrate, GainNumber of them
+    Rate       : data rates to calibrate, RateNumber of them
+Info:
+    ADC1 is set up and started for each combination in turn, then Base
+    is restored with its own coefficients, or the reset values if Base
+    is not in the table. Each calibration takes
+    about 17 settling times, so slow rates dominate the sweep.
+    Return 0 success, 1 some combination failed
+******************************************************************************/
+UBYTE ADS1263_Calib_Sweep(ADS1263_DEVICE *Dev, ADS1263_CALIB *Cal, const ADS1263_ADC1_CONFIG *Base,
+    const ADS1263_GAIN *Gain, UBYTE GainNumber, const ADS1263_DRATE *Rate, UBYTE RateNumber)
+{
+    ADS1263_ADC1_CONFIG Config = *Base;
+    UBYTE g, r, err = 0;
+
+    for(g = 0; g < GainNumber; g++) {
+        for(r = 0; r < RateNumber; r++) {
+            Config.Gain = Gain[g];
+            Config.Rate = Rate[r];
+            if(ADS1263_ConfigureADC1(Dev, &Config) != 0) {
+                err = 1;
+                continue;
+            }
+            ADS1263_WriteCmd(Dev, CMD_START1);
+            if(ADS1263_Calib_Run(Dev, Cal, CMD_SFOCAL1) != 0)
+                err = 1;
+        }
+    }
+    ADS1263_ConfigureADC1(Dev, Base);
+    if(ADS1263_Calib_Apply(Dev, Cal) != 0)
+        ADS1263_Calib_Write(Dev, ADS1263_Calib_Default);   // not the last combination's
+    ADS1263_WriteCmd(Dev, CMD_START1);
+    return err;
+}
+
+/******************************************************************************
+function:   Load the coefficients for the current gain and data rate
+parameter:
+Info:
+    One WREG of OFCAL0 to FSCAL2; call it again after a gain or rate change.
+    Return 0 success, 1 no entry for this set-up, the chip is left alone
+******************************************************************************/
+UBYTE ADS1263_Calib_Apply(ADS1263_DEVICE *Dev, const ADS1263_CALIB *Cal)
+{
+    ADS1263_CALIB_ENTRY *Entry = ADS1263_Calib_Find(Cal, ADS1263_GetReg(Dev, REG_MODE2));
+    UBYTE Coef[6];
+
+    if(Entry == NULL) {
+        return 1;
+    }
+    memcpy(Coef, Entry->OFCAL, 3);
+    memcpy(Coef + 3, Entry->FSCAL, 3);
+    ADS1263_Calib_Write(Dev, Coef);
+    return 0;
+}
+
+/******************************************************************************
+function:   Store the table
+parameter:
+    Path : file, replaced as a whole
+Info:
+    Written to <Path>.tmp and renamed over Path, so a crash leaves either
+    the old or the new file, never half of one.
+    Return 0 success, 1 failed
+******************************************************************************/
+UBYTE ADS1263_Calib_Save(const ADS1263_CALIB *Cal, const char *Path)
+{
+    ADS1263_CALIB_HEADER Header;
+    char Tmp[ADS1263_CALIB_PATHLEN];
+    FILE *fp;
+    int ok;
+
+    if(snprintf(Tmp, sizeof(Tmp), "%s.tmp", Path) >= (int)sizeof(Tmp)) {
+        Log_Error("ADS1263_Calib_Save: path too long \r\n");
+        return 1;
+    }
+    memcpy(Header.Magic, ADS1263_CALIB_MAGIC, sizeof(Header.Magic));
+    Header.Version = ADS1263_CALIB_VERSION;
+    Header.Number = Cal->Number;
+    Header.Sum = ADS1263_Calib_Sum(Cal);
+
+    fp = fopen(Tmp, "wb");
+    if(fp == NULL) {
+        Log_Error("ADS1263_Calib_Save: cannot create %s: %s \r\n", Tmp, strerror(errno));
+        return 1;
+    }
+    ok = fwrite(&Header, sizeof(Header), 1, fp) == 1
+        && fwrite(Cal->Entry, sizeof(ADS1263_CALIB_ENTRY), Cal->Number, fp) == Cal->Number;
+    ok = (fclose(fp) == 0) && ok;
+    if(!ok || rename(Tmp, Path) != 0) {
+        Log_Error("ADS1263_Calib_Save: cannot write %s: %s \r\n", Path, strerror(errno));
+        remove(Tmp);
+        return 1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+function:   Read a table stored by ADS1263_Calib_Save
+parameter:
+Info:
+    Cal is left empty if the file is missing, short or damaged.
+    Return 0 success, 1 failed
+******************************************************************************/
+UBYTE ADS1263_Calib_Load(ADS1263_CALIB *Cal, const char *Path)
+{
+    ADS1263_CALIB_HEADER Header;
+    FILE *fp;
+    int ok;
+
+    ADS1263_Calib_Init(Cal);
+    fp = fopen(Path, "rb");
+    if(fp == NULL) {
+        Log_Warn("ADS1263_Calib_Load: cannot open %s: %s \r\n", Path, strerror(errno));
+        return 1;
+    }
+    ok = fread(&Header, sizeof(Header), 1, fp) == 1
+        && memcmp(Header.Magic, ADS1263_CALIB_MAGIC, sizeof(Header.Magic)) == 0
+        && Header.Version == ADS1263_CALIB_VERSION
+        && Header.Number <= ADS1263_CALIB_MAX
+        && fread(Cal->Entry, sizeof(ADS1263_CALIB_ENTRY), Header.Number, fp) == Header.Number;
+    fclose(fp);
+    if(ok) {
+        Cal->Number = Header.Number;
+        ok = ADS1263_Calib_Sum(Cal) == Header.Sum;
+    }
+    if(!ok) {
+        Log_Error("ADS1263_Calib_Load: %s is not a calibration file \r\n", Path);
+        ADS1263_Calib_Init(Cal);
+        return 1;
+    }
+    return 0;
+}
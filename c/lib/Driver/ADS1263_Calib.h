@@ -0,0 +1,80 @@
+/*****************************************************************************
+* | File        :   ADS1263_Calib.h
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 calibration coefficients per gain and data rate
+* | Info        :
+*   Self/system calibration, kept in a small file and written back
+*   to OFCAL/FSCAL in one burst
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_CALIB_H_
+#define _ADS1263_CALIB_H_
+
+#include "ADS1263.h"
+
+#define ADS1263_CALIB_MAGIC     "ADS1263K"
+#define ADS1263_CALIB_VERSION   1
+#define ADS1263_CALIB_MAX       128     // 8 gains x 16 data rates
+#define ADS1263_CALIB_PATHLEN   256
+
+/* ADS1263_CALIB_ENTRY.Flags */
+#define ADS1263_CALIB_OFFSET    0x01    // OFCAL from a self or system offset calibration
+#define ADS1263_CALIB_GAIN      0x02    // FSCAL from a system gain calibration
+
+/**
+ * Coefficients for one REG_MODE2 value: PGA bypass, gain and data rate.
+ * Filter and chop are not part of the key.
+**/
+typedef struct {
+    UBYTE Mode2;        // REG_MODE2 the coefficients were measured at
+    UBYTE Flags;        // ADS1263_CALIB_xxx
+    UBYTE OFCAL[3];     // REG_OFCAL0..2 as read from the chip
+    UBYTE FSCAL[3];     // REG_FSCAL0..2
+} ADS1263_CALIB_ENTRY;
+
+/**
+ * File layout: this header, then Number entries of 8 bytes
+**/
+typedef struct {
+    char Magic[8];      // ADS1263_CALIB_MAGIC, not terminated
+    UWORD Version;      // ADS1263_CALIB_VERSION
+    UWORD Number;       // entries that follow
+    UDOUBLE Sum;        // byte sum of the entries
+} ADS1263_CALIB_HEADER;
+
+typedef struct {
+    ADS1263_CALIB_ENTRY Entry[ADS1263_CALIB_MAX];
+    UWORD Number;
+} ADS1263_CALIB;
+
+void ADS1263_Calib_Init(ADS1263_CALIB *Cal);
+UBYTE ADS1263_Calib_Run(ADS1263_DEVICE *Dev, ADS1263_CALIB *Cal, UBYTE Cmd);
+UBYTE ADS1263_Calib_Sweep(ADS1263_DEVICE *Dev, ADS1263_CALIB *Cal, const ADS1263_ADC1_CONFIG *Base,
+    const ADS1263_GAIN *Gain, UBYTE GainNumber, const ADS1263_DRATE *Rate, UBYTE RateNumber);
+UBYTE ADS1263_Calib_Apply(ADS1263_DEVICE *Dev, const ADS1263_CALIB *Cal);
+UBYTE ADS1263_Calib_Save(const ADS1263_CALIB *Cal, const char *Path);
+UBYTE ADS1263_Calib_Load(ADS1263_CALIB *Cal, const char *Path);
+
+#endif
@@ -0,0 +1,226 @@
+/*****************************************************************************
+* | File        :   ADS1263_Capture.c
+* | Author      :   Waveshare team
+* | Function    :   Binary capture of ADS1263 samples to disk
+* | Info        :
+*   Fixed-size records in preallocated, memory-mapped segment files
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "ADS1263_Capture.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+_Static_assert(sizeof(ADS1263_CAPTURE_HEADER) == 64, "capture header is 64 bytes");
+_Static_assert(sizeof(ADS1263_SAMPLE) == 16, "capture record is 16 bytes");
+
+/******************************************************************************
+function:   Create, preallocate and map the next segment
+parameter:
+Info:
+    The blocks are allocated up front, so a full disk shows up here and
+    not as SIGBUS on a store into the mapping.
+    Return 0 success, 1 failed
+******************************************************************************/
+static UBYTE ADS1263_Capture_Map(ADS1263_CAPTURE *Cap)
+{
+    char Path[ADS1263_CAPTURE_PATHLEN + 16];
+    ADS1263_CAPTURE_HEADER *Header;
+    int err;
+
+    snprintf(Path, sizeof(Path), "%s_%04u.bin", Cap->Prefix, Cap->Segment);
+    Cap->fd = open(Path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(Cap->fd < 0) {
+        Log_Error("ADS1263_Capture: cannot create %s: %s \r\n", Path, strerror(errno));
+        return 1;
+    }
+    Cap->MapSize = sizeof(ADS1263_CAPTURE_HEADER) + (size_t)Cap->Capacity * sizeof(ADS1263_SAMPLE);
+    err = posix_fallocate(Cap->fd, 0, Cap->MapSize);
+    if(err != 0) {
+        Log_Error("ADS1263_Capture: cannot allocate %s: %s \r\n", Path, strerror(err));
+        goto fail;
+    }
+    Header = (ADS1263_CAPTURE_HEADER *)mmap(NULL, Cap->MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, Cap->fd, 0);
+    if(Header == MAP_FAILED) {
+        Log_Error("ADS1263_Capture: cannot map %s: %s \r\n", Path, strerror(errno));
+        goto fail;
+    }
+    // written once, front to back
+    madvise(Header, Cap->MapSize, MADV_SEQUENTIAL);
+
+    memset(Header, 0, sizeof(*Header));
+    memcpy(Header->Magic, ADS1263_CAPTURE_MAGIC, sizeof(Header->Magic));
+    Header->Version = ADS1263_CAPTURE_VERSION;
+    Header->RecordSize = sizeof(ADS1263_SAMPLE);
+    Header->Segment = Cap->Segment;
+    Header->Capacity = Cap->Capacity;
+    Header->First = Cap->Written;
+    Cap->Header = Header;
+    Cap->Record = (ADS1263_SAMPLE *)(Header + 1);
+    return 0;
+
+fail:
+    close(Cap->fd);
+    unlink(Path);
+    Cap->fd = -1;
+    return 1;
+}
+
+/******************************************************************************
+function:   Finish the current segment
+parameter:
+Info:
+    A segment closed before it is full is cut down to its records.
+    The write-back is left to the kernel, nothing here waits for the disk.
+******************************************************************************/
+static void ADS1263_Capture_Unmap(ADS1263_CAPTURE *Cap)
+{
+    UDOUBLE Count = Cap->Header->Count;
+
+    munmap(Cap->Header, Cap->MapSize);
+    if(Count < Cap->Capacity)
+        ftruncate(Cap->fd, sizeof(ADS1263_CAPTURE_HEADER) + (off_t)Count * sizeof(ADS1263_SAMPLE));
+    close(Cap->fd);
+    Cap->fd = -1;
+    Cap->Header = NULL;
+    Cap->Record = NULL;
+}
+
+/******************************************************************************
+function:   Start a capture
+parameter:
+    Cap          : capture object
+    Prefix       : path prefix, segments are <Prefix>_0000.bin, _0001.bin, ...
+    SegmentBytes : size of one segment file, header included
+Info:
+    The first segment is created and preallocated here.
+    Return 0 success, 1 failed
+******************************************************************************/
+UBYTE ADS1263_Capture_Open(ADS1263_CAPTURE *Cap, const char *Prefix, UDOUBLE SegmentBytes)
+{
+    if(strlen(Prefix) >= ADS1263_CAPTURE_PATHLEN || SegmentBytes < sizeof(ADS1263_CAPTURE_HEADER) + sizeof(ADS1263_SAMPLE)) {
+        Log_Error("ADS1263_Capture_Open: bad prefix or segment size \r\n");
+        return 1;
+    }
+    strcpy(Cap->Prefix, Prefix);
+    Cap->Capacity = (SegmentBytes - sizeof(ADS1263_CAPTURE_HEADER)) / sizeof(ADS1263_SAMPLE);
+    Cap->Segment = 0;
+    Cap->Written = 0;
+    Cap->Header = NULL;
+    Cap->Record = NULL;
+    return ADS1263_Capture_Map(Cap);
+}
+
+/******************************************************************************
+function:   Append samples
+parameter:
+    Sample : first sample
+    Count  : number of samples
+Info:
+    Records are copied straight into the mapped file; a full segment is
+    closed and the next one opened. The header count is raised after the
+    records, so a segment cut short by a crash reads back up to it.
+    Return the number of samples written, less than Count once no segment
+    could be opened; the capture stays failed, see ADS1263_Capture_IsOpen
+******************************************************************************/
+UDOUBLE ADS1263_Capture_Write(ADS1263_CAPTURE *Cap, const ADS1263_SAMPLE *Sample, UDOUBLE Count)
+{
+    UDOUBLE Used, n, Total = 0;
+
+    while(Count > 0) {
+        if(Cap->fd < 0)
+            return Total;
+        Used = Cap->Header->Count;
+        if(Used == Cap->Capacity) {
+            ADS1263_Capture_Unmap(Cap);
+            Cap->Segment++;
+            if(ADS1263_Capture_Map(Cap) != 0)
+                return Total;
+            Used = 0;
+        }
+        if(Used == 0)
+            Cap->Header->Start_ns = Sample->Time_ns;
+
+        n = Cap->Capacity - Used;
+        if(n > Count)
+            n = Count;
+        memcpy(&Cap->Record[Used], Sample, n * sizeof(ADS1263_SAMPLE));
+        Cap->Header->Count = Used + n;
+        Cap->Written += n;
+        Total += n;
+        Sample += n;
+        Count -= n;
+    }
+    return Total;
+}
+
+/******************************************************************************
+function:   Move everything waiting in a stream's ring to disk
+parameter:
+    Stream : running or stopped stream, this is its consumer
+Info:
+    Samples go from the ring to the mapping without a staging buffer.
+    Exactly the samples that reached the file are released; on a write
+    failure the rest stays in the ring and ADS1263_Capture_IsOpen turns 0.
+    Return the number of samples written
+******************************************************************************/
+UDOUBLE ADS1263_Capture_Drain(ADS1263_CAPTURE *Cap, ADS1263_STREAM *Stream)
+{
+    ADS1263_SAMPLE *Batch;
+    UDOUBLE Total = 0, n, w;
+
+    while((n = ADS1263_Stream_Peek(Stream, &Batch)) > 0) {
+        w = ADS1263_Capture_Write(Cap, Batch, n);
+        ADS1263_Stream_Release(Stream, w);
+        Total += w;
+        if(w < n)
+            break;
+    }
+    return Total;
+}
+
+/******************************************************************************
+function:   Tell whether the capture still has a segment to write to
+parameter:
+Info:   Return 1 open, 0 failed or closed; a failed capture stays failed
+******************************************************************************/
+UBYTE ADS1263_Capture_IsOpen(const ADS1263_CAPTURE *Cap)
+{
+    return Cap->fd >= 0;
+}
+
+/******************************************************************************
+function:   Finish the capture
+parameter:
+Info:   Return 0 success, 1 the capture had already failed
+******************************************************************************/
+UBYTE ADS1263_Capture_Close(ADS1263_CAPTURE *Cap)
+{
+    if(Cap->fd < 0)
+        return 1;
+    ADS1263_Capture_Unmap(Cap);
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+* | File        :   ADS1263_Capture.h
+* | Author      :   Waveshare team
+* | Function    :   Binary capture of ADS1263 samples to disk
+* | Info        :
+*   Fixed-size records in preallocated, memory-mapped segment files
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_CAPTURE_H_
+#define _ADS1263_CAPTURE_H_
+
+#include "ADS1263_Stream.h"
+
+#define ADS1263_CAPTURE_MAGIC       "ADS1263C"
+#define ADS1263_CAPTURE_VERSION     1
+#define ADS1263_CAPTURE_PATHLEN     256
+
+/**
+ * First 64 bytes of every segment. The records follow it, each one an
+ * ADS1263_SAMPLE as it sits in memory (little-endian, 16 bytes).
+**/
+typedef struct {
+    char Magic[8];          // ADS1263_CAPTURE_MAGIC, not terminated
+    UWORD Version;          // ADS1263_CAPTURE_VERSION
+    UWORD RecordSize;       // sizeof(ADS1263_SAMPLE)
+    UDOUBLE Segment;        // sequence number, from 0
+    UDOUBLE Capacity;       // records the segment has room for
+    UDOUBLE Count;          // records written so far
+    uint64_t Start_ns;      // Time_ns of the first record
+    uint64_t First;         // records written to earlier segments
+    UBYTE Reserved[24];
+} ADS1263_CAPTURE_HEADER;
+
+typedef struct {
+    char Prefix[ADS1263_CAPTURE_PATHLEN];  // segment n is <Prefix>_<n>.bin
+    UDOUBLE Capacity;                   // records per segment
+    UDOUBLE Segment;                    // segment being written
+    uint64_t Written;                   // records in all segments so far
+
+    int fd;                             // -1 while no segment is open
+    size_t MapSize;
+    ADS1263_CAPTURE_HEADER *Header;     // start of the mapping
+    ADS1263_SAMPLE *Record;             // first record slot
+} ADS1263_CAPTURE;
+
+UBYTE ADS1263_Capture_Open(ADS1263_CAPTURE *Cap, const char *Prefix, UDOUBLE SegmentBytes);
+UDOUBLE ADS1263_Capture_Write(ADS1263_CAPTURE *Cap, const ADS1263_SAMPLE *Sample, UDOUBLE Count);
+UDOUBLE ADS1263_Capture_Drain(ADS1263_CAPTURE *Cap, ADS1263_STREAM *Stream);
+UBYTE ADS1263_Capture_IsOpen(const ADS1263_CAPTURE *Cap);
+UBYTE ADS1263_Capture_Close(ADS1263_CAPTURE *Cap);
+
+#endif
@@ -0,0 +1,131 @@
+/*****************************************************************************
+* | File        :   ADS1263_Convert.c
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 raw code to voltage conversion
+* | Info        :
+*   Block conversion of ADC1 (32-bit) and ADC2 (24-bit) codes, NEON when
+*   the compiler targets it, branch-free scalar code otherwise.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "ADS1263_Convert.h"
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+/******************************************************************************
+function:   Set up ADC1 conversion
+parameter:
+    Conv   : conversion to fill in
+    Ref    : reference voltage, e.g. 5.08 for AVDD-AVSS or 2.5 internal
+    Gain   : PGA gain ADC1 was configured with
+    Offset : volts to subtract, e.g. a measured zero reading
+Info:
+******************************************************************************/
+void ADS1263_VConv_ADC1(ADS1263_VCONV *Conv, double Ref, ADS1263_GAIN Gain, double Offset)
+{
+    Conv->ScaleD = Ref / (double)(1U << Gain) / 2147483648.0;   // 7fffffff + 1
+    Conv->OffsetD = Offset;
+    Conv->Scale = (float)Conv->ScaleD;
+    Conv->Offset = (float)Offset;
+    Conv->Shift = 0;
+}
+
+/******************************************************************************
+function:   Set up ADC2 conversion
+parameter:
+    Conv   : conversion to fill in
+    Ref    : reference voltage
+    Gain   : PGA gain ADC2 was configured with
+    Offset : volts to subtract
+Info:
+******************************************************************************/
+void ADS1263_VConv_ADC2(ADS1263_VCONV *Conv, double Ref, ADS1263_ADC2_GAIN Gain, double Offset)
+{
+    // the 24-bit code moved to the top of a 32-bit word
+    Conv->ScaleD = Ref / (double)(1U << Gain) / 2147483648.0;
+    Conv->OffsetD = Offset;
+    Conv->Scale = (float)Conv->ScaleD;
+    Conv->Offset = (float)Offset;
+    Conv->Shift = 8;
+}
+
+/******************************************************************************
+function:   Convert a block of raw codes to float volts
+parameter:
+    Conv   : ADS1263_VConv_ADC1 or ADS1263_VConv_ADC2 result
+    Code   : raw codes as returned by the driver
+    Volt   : Number results, may not overlap Code
+    Number : block length
+Info:
+    Sign extension is a shift and a signed conversion, no branches.
+    A float keeps 24 bits of an ADC1 code; use the double version when
+    the full resolution matters.
+******************************************************************************/
+void ADS1263_ToVolt(const ADS1263_VCONV *Conv, const UDOUBLE *Code, float *Volt, UDOUBLE Number)
+{
+    UDOUBLE i = 0;
+#ifdef __ARM_NEON
+    const int32x4_t Shift = vdupq_n_s32(Conv->Shift);
+    const float32x4_t Scale = vdupq_n_f32(Conv->Scale);
+    const float32x4_t Offset = vdupq_n_f32(Conv->Offset);
+    for(; i + 4 <= Number; i += 4) {
+        int32x4_t c = vreinterpretq_s32_u32(vshlq_u32(vld1q_u32(&Code[i]), Shift));
+        vst1q_f32(&Volt[i], vsubq_f32(vmulq_f32(vcvtq_f32_s32(c), Scale), Offset));
+    }
+#endif
+    for(; i < Number; i++) {
+        Volt[i] = (float)(int32_t)(Code[i] << Conv->Shift) * Conv->Scale - Conv->Offset;
+    }
+}
+
+/******************************************************************************
+function:   Convert a block of raw codes to double volts
+parameter:
+    Conv   : ADS1263_VConv_ADC1 or ADS1263_VConv_ADC2 result
+    Code   : raw codes as returned by the driver
+    Volt   : Number results
+    Number : block length
+Info:
+    Exact for every code; vectorised on 64-bit ARM only
+******************************************************************************/
+void ADS1263_ToVolt_Double(const ADS1263_VCONV *Conv, const UDOUBLE *Code, double *Volt, UDOUBLE Number)
+{
+    UDOUBLE i = 0;
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    const int32x4_t Shift = vdupq_n_s32(Conv->Shift);
+    const float64x2_t Scale = vdupq_n_f64(Conv->ScaleD);
+    const float64x2_t Offset = vdupq_n_f64(Conv->OffsetD);
+    for(; i + 4 <= Number; i += 4) {
+        int32x4_t c = vreinterpretq_s32_u32(vshlq_u32(vld1q_u32(&Code[i]), Shift));
+        float64x2_t lo = vcvtq_f64_s64(vmovl_s32(vget_low_s32(c)));
+        float64x2_t hi = vcvtq_f64_s64(vmovl_high_s32(c));
+        vst1q_f64(&Volt[i], vsubq_f64(vmulq_f64(lo, Scale), Offset));
+        vst1q_f64(&Volt[i + 2], vsubq_f64(vmulq_f64(hi, Scale), Offset));
+    }
+#endif
+    for(; i < Number; i++) {
+        Volt[i] = (double)(int32_t)(Code[i] << Conv->Shift) * Conv->ScaleD - Conv->OffsetD;
+    }
+}
@@ -0,0 +1,55 @@
+/*****************************************************************************
+* | File        :   ADS1263_Convert.h
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 raw code to voltage conversion
+* | Info        :
+*   Block conversion of ADC1 (32-bit) and ADC2 (24-bit) codes, NEON when
+*   the compiler targets it, branch-free scalar code otherwise.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_CONVERT_H_
+#define _ADS1263_CONVERT_H_
+
+#include "ADS1263.h"
+
+/**
+ * Code to volts for one converter setting, V = code * Scale - Offset.
+ * ADC2 codes are shifted up 8 bits first, so both share the 2^31 scale.
+**/
+typedef struct {
+    float Scale;        // volts per code at the input, gain applied
+    float Offset;       // volts subtracted after scaling
+    double ScaleD;      // the same in double, for ADS1263_ToVolt_Double
+    double OffsetD;
+    UBYTE Shift;        // 0 ADC1, 8 ADC2: puts the sign bit at bit 31
+} ADS1263_VCONV;
+
+void ADS1263_VConv_ADC1(ADS1263_VCONV *Conv, double Ref, ADS1263_GAIN Gain, double Offset);
+void ADS1263_VConv_ADC2(ADS1263_VCONV *Conv, double Ref, ADS1263_ADC2_GAIN Gain, double Offset);
+
+void ADS1263_ToVolt(const ADS1263_VCONV *Conv, const UDOUBLE *Code, float *Volt, UDOUBLE Number);
+void ADS1263_ToVolt_Double(const ADS1263_VCONV *Conv, const UDOUBLE *Code, double *Volt, UDOUBLE Number);
+
+#endif
@@ -0,0 +1,223 @@
+/*****************************************************************************
+* | File        :   ADS1263_Decim.c
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 decimation stages
+* | Info        :
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "ADS1263_Decim.h"
+#include <math.h>
+
+/* RMS squares the code without its 8 noise-only low bits, 46 bits a square */
+#define DECIM_RMS_SHIFT     8
+#define DECIM_RMS_MAX       65536
+
+/******************************************************************************
+function:   Set up a stage
+parameter:
+    Decim      : stage to fill
+    Type       : ADS1263_DECIM_xxx
+    Decimation : samples in per result out, 1 or more
+    Order      : CIC stages, 1 - ADS1263_DECIM_MAXORDER; ignored otherwise
+Info:
+    A CIC has a gain of Decimation^Order, which has to fit the 64-bit
+    registers on top of the 32-bit code: Order * log2(Decimation) <= 32.
+    RMS blocks are at most 65536 samples.
+    Return 0 success, 1 bad parameters
+******************************************************************************/
+UBYTE ADS1263_Decim_Init(ADS1263_DECIM *Decim, ADS1263_DECIM_TYPE Type, UDOUBLE Decimation, UBYTE Order)
+{
+    UBYTE Bits = 0, i;
+
+    if(Type > ADS1263_DECIM_RMS || Decimation == 0) {
+        return 1;
+    }
+    if(Type == ADS1263_DECIM_RMS && Decimation > DECIM_RMS_MAX) {
+        return 1;
+    }
+    while(Bits < 32 && (1UL << Bits) < Decimation)
+        Bits++;
+    if(Type == ADS1263_DECIM_CIC) {
+        if(Order == 0 || Order > ADS1263_DECIM_MAXORDER || Order * Bits > 32) {
+            return 1;
+        }
+    } else {
+        Order = 1;
+    }
+    Decim->Type = Type;
+    Decim->Decimation = Decimation;
+    Decim->Order = Order;
+    Decim->Gain = 1;
+    for(i = 0; i < Order; i++)
+        Decim->Gain *= Decimation;
+    Decim->Shift = (1UL << Bits) == Decimation ? Bits * Order : 0xff;
+    Decim->Next = NULL;
+    ADS1263_Decim_Reset(Decim);
+    return 0;
+}
+
+/******************************************************************************
+function:   Feed the results of one stage into another
+parameter:
+    Next : following stage, NULL ends the pipeline here
+Info:
+    For example a CIC by 16 into a boxcar by 4 gives 1/64 of the rate
+******************************************************************************/
+void ADS1263_Decim_Chain(ADS1263_DECIM *Decim, ADS1263_DECIM *Next)
+{
+    Decim->Next = Next;
+}
+
+/******************************************************************************
+function:   Drop every partial block
+parameter:
+Info:
+    Does not reset the stages chained after this one
+******************************************************************************/
+void ADS1263_Decim_Reset(ADS1263_DECIM *Decim)
+{
+    memset(Decim->Acc, 0, sizeof(Decim->Acc));
+    memset(Decim->Integ, 0, sizeof(Decim->Integ));
+    memset(Decim->Comb, 0, sizeof(Decim->Comb));
+    memset(Decim->Count, 0, sizeof(Decim->Count));
+    memset(Decim->Flags, 0, sizeof(Decim->Flags));
+}
+
+/******************************************************************************
+function:   Take one sample
+parameter:
+    In  : sample, its Channel picks the state
+    Out : receives a result, may be In
+Info:
+    The result carries the mean of the first and last time stamps of its
+    block, the status byte of the last sample and the flags of all of
+    them OR-ed together; CRC is 0. The first Order CIC results are still
+    settling. Timeouts and channels above 15 are ignored.
+    Return 1 Out holds a result of the last chained stage, 0 not yet
+******************************************************************************/
+UBYTE ADS1263_Decim_Push(ADS1263_DECIM *Decim, const ADS1263_SAMPLE *In, ADS1263_SAMPLE *Out)
+{
+    UBYTE c = In->Channel, k;
+    int32_t x = (int32_t)In->Value;
+    int64_t r = 0, v;
+    uint64_t y, t;
+    ADS1263_SAMPLE Res;
+
+    if(c >= ADS1263_DECIM_MAXCH || (In->Flags & ADS1263_SAMPLE_TIMEOUT)) {
+        return 0;
+    }
+    if(Decim->Count[c] == 0) {
+        Decim->First_ns[c] = In->Time_ns;
+        Decim->Flags[c] = 0;
+        Decim->Acc[c] = 0;
+        Decim->Min[c] = x;
+        Decim->Max[c] = x;
+    }
+    Decim->Flags[c] |= In->Flags;
+
+    switch(Decim->Type) {
+    case ADS1263_DECIM_MEAN:
+        Decim->Acc[c] += x;
+        break;
+    case ADS1263_DECIM_RMS:
+        v = x >> DECIM_RMS_SHIFT;
+        Decim->Acc[c] += v * v;
+        break;
+    case ADS1263_DECIM_MIN:
+        Decim->Min[c] = x < Decim->Min[c] ? x : Decim->Min[c];
+        break;
+    case ADS1263_DECIM_MAX:
+        Decim->Max[c] = x > Decim->Max[c] ? x : Decim->Max[c];
+        break;
+    case ADS1263_DECIM_CIC:
+        Decim->Integ[0][c] += (uint64_t)(int64_t)x;
+        for(k = 1; k < Decim->Order; k++)
+            Decim->Integ[k][c] += Decim->Integ[k - 1][c];
+        break;
+    }
+    if(++Decim->Count[c] < Decim->Decimation) {
+        return 0;
+    }
+    Decim->Count[c] = 0;
+
+    switch(Decim->Type) {
+    case ADS1263_DECIM_MEAN:
+        r = Decim->Acc[c] / (int64_t)Decim->Decimation;
+        break;
+    case ADS1263_DECIM_RMS:
+        r = (int64_t)sqrt((double)Decim->Acc[c] / Decim->Decimation) << DECIM_RMS_SHIFT;
+        break;
+    case ADS1263_DECIM_MIN:
+        r = Decim->Min[c];
+        break;
+    case ADS1263_DECIM_MAX:
+        r = Decim->Max[c];
+        break;
+    case ADS1263_DECIM_CIC:
+        y = Decim->Integ[Decim->Order - 1][c];
+        for(k = 0; k < Decim->Order; k++) {
+            t = y;
+            y -= Decim->Comb[k][c];
+            Decim->Comb[k][c] = t;
+        }
+        if(Decim->Shift != 0xff)
+            r = (int64_t)y >> Decim->Shift;
+        else
+            r = (int64_t)y / (int64_t)Decim->Gain;
+        break;
+    }
+    if(r > INT32_MAX)
+        r = INT32_MAX;
+
+    Res.Time_ns = Decim->First_ns[c] + (In->Time_ns - Decim->First_ns[c]) / 2;
+    Res.Value = (UDOUBLE)(int32_t)r;
+    Res.Channel = c;
+    Res.Status = In->Status;
+    Res.CRC = 0;
+    Res.Flags = Decim->Flags[c];
+    *Out = Res;
+    if(Decim->Next != NULL) {
+        return ADS1263_Decim_Push(Decim->Next, Out, Out);
+    }
+    return 1;
+}
+
+/******************************************************************************
+function:   Reduce a batch
+parameter:
+    In     : samples, any mix of channels
+    Number : how many
+    Out    : receives the results, may be In
+Info:
+    Return the number of results
+******************************************************************************/
+UDOUBLE ADS1263_Decim_Block(ADS1263_DECIM *Decim, const ADS1263_SAMPLE *In, UDOUBLE Number, ADS1263_SAMPLE *Out)
+{
+    UDOUBLE i, n = 0;
+    for(i = 0; i < Number; i++) {
+        n += ADS1263_Decim_Push(Decim, &In[i], &Out[n]);
+    }
+    return n;
+}
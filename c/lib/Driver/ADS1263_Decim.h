@@ -0,0 +1,78 @@
+/*****************************************************************************
+* | File        :   ADS1263_Decim.h
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 decimation stages
+* | Info        :
+*   Per-channel block average, CIC, min, max and RMS reduction of a
+*   sample stream, so only the reduced results reach the consumer
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_DECIM_H_
+#define _ADS1263_DECIM_H_
+
+#include "ADS1263.h"
+
+#define ADS1263_DECIM_MAXCH     16      // Channel 0-15 each get their own state
+#define ADS1263_DECIM_MAXORDER  4       // CIC stages
+
+typedef enum
+{
+    ADS1263_DECIM_MEAN = 0,     // boxcar: average of each block of Decimation samples
+    ADS1263_DECIM_CIC,          // Order integrator/comb pairs at a rate change of Decimation
+    ADS1263_DECIM_MIN,          // smallest code of each block
+    ADS1263_DECIM_MAX,          // largest code of each block
+    ADS1263_DECIM_RMS,          // root mean square of each block
+}ADS1263_DECIM_TYPE;
+
+/**
+ * One stage. The channel state is kept as parallel arrays indexed by
+ * ADS1263_SAMPLE.Channel, so a scan touches the same few cache lines
+ * each time round. Codes are taken as signed 32-bit and summed in 64 bits.
+**/
+typedef struct ADS1263_DecimStruct {
+    ADS1263_DECIM_TYPE Type;
+    UDOUBLE Decimation;                 // samples in per result out
+    UBYTE Order;                        // CIC only
+    UBYTE Shift;                        // CIC gain Decimation^Order as a shift, 0xff divide by Gain
+    uint64_t Gain;
+    struct ADS1263_DecimStruct *Next;   // stage fed with this one's results, NULL none
+
+    int64_t Acc[ADS1263_DECIM_MAXCH];                       // sum, sum of squares
+    uint64_t Integ[ADS1263_DECIM_MAXORDER][ADS1263_DECIM_MAXCH];   // CIC, wrapping
+    uint64_t Comb[ADS1263_DECIM_MAXORDER][ADS1263_DECIM_MAXCH];
+    int32_t Min[ADS1263_DECIM_MAXCH];
+    int32_t Max[ADS1263_DECIM_MAXCH];
+    UDOUBLE Count[ADS1263_DECIM_MAXCH]; // samples in the current block
+    uint64_t First_ns[ADS1263_DECIM_MAXCH];
+    UBYTE Flags[ADS1263_DECIM_MAXCH];   // ADS1263_SAMPLE_xxx of the block so far
+} ADS1263_DECIM;
+
+UBYTE ADS1263_Decim_Init(ADS1263_DECIM *Decim, ADS1263_DECIM_TYPE Type, UDOUBLE Decimation, UBYTE Order);
+void ADS1263_Decim_Chain(ADS1263_DECIM *Decim, ADS1263_DECIM *Next);
+void ADS1263_Decim_Reset(ADS1263_DECIM *Decim);
+UBYTE ADS1263_Decim_Push(ADS1263_DECIM *Decim, const ADS1263_SAMPLE *In, ADS1263_SAMPLE *Out);
+UDOUBLE ADS1263_Decim_Block(ADS1263_DECIM *Decim, const ADS1263_SAMPLE *In, UDOUBLE Number, ADS1263_SAMPLE *Out);
+
+#endif
@@ -0,0 +1,159 @@
+/*****************************************************************************
+* | File        :   ADS1263_Multi.c
+* | Author      :   Waveshare team
+* | Function    :   Parallel acquisition on several ADS1263
+* | Info        :
+*   One ADS1263_Stream per device, merged in DRDY time order
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "ADS1263_Multi.h"
+
+/******************************************************************************
+function:   Prepare an empty device set
+parameter:
+    Multi : device set
+    Size  : ring capacity given to each device's stream
+Info:
+******************************************************************************/
+void ADS1263_Multi_Init(ADS1263_MULTI *Multi, UDOUBLE Size)
+{
+    Multi->Number = 0;
+    Multi->Size = Size;
+}
+
+/******************************************************************************
+function:   Start streaming one more device
+parameter:
+    Multi  : device set
+    Dev    : device, initialised with ADS1263_init_ADC1
+    List   : channels to cycle through, as for ADS1263_Stream_Start
+    Number : list length
+    CPU    : core for the device's thread, -1 any
+Info:
+    Devices added later start later, so the merge only holds samples back
+    from the moment every device is running.
+    Return 0 success, 1 failed
+******************************************************************************/
+UBYTE ADS1263_Multi_Add(ADS1263_MULTI *Multi, ADS1263_DEVICE *Dev, const UBYTE *List, UBYTE Number, int CPU)
+{
+    ADS1263_STREAM *Stream;
+
+    if(Multi->Number >= ADS1263_MULTI_MAXDEV) {
+        Log_Error("ADS1263_Multi_Add: at most %d devices \r\n", ADS1263_MULTI_MAXDEV);
+        return 1;
+    }
+    if(ADS1263_Stream_CheckList(Dev, List, Number) != 0)
+        return 1;
+    Stream = &Multi->Stream[Multi->Number];
+    if(ADS1263_Stream_Init(Stream, Multi->Size) != 0)
+        return 1;
+    ADS1263_Stream_SetCPU(Stream, CPU);
+    if(ADS1263_Stream_Start(Stream, Dev, List, Number) != 0) {
+        ADS1263_Stream_Free(Stream);
+        return 1;
+    }
+    Multi->Number++;
+    return 0;
+}
+
+/******************************************************************************
+function:   Stop every device's thread
+parameter:
+Info:   Samples already captured can still be read
+******************************************************************************/
+void ADS1263_Multi_Stop(ADS1263_MULTI *Multi)
+{
+    UBYTE i;
+    for(i = 0; i < Multi->Number; i++)
+        ADS1263_Stream_Stop(&Multi->Stream[i]);
+}
+
+/******************************************************************************
+function:   Stop the threads and release the rings
+parameter:
+Info:
+******************************************************************************/
+void ADS1263_Multi_Free(ADS1263_MULTI *Multi)
+{
+    UBYTE i;
+    for(i = 0; i < Multi->Number; i++)
+        ADS1263_Stream_Free(&Multi->Stream[i]);
+    Multi->Number = 0;
+}
+
+/******************************************************************************
+function:   Copy out up to Max samples of all devices in timestamp order
+parameter:
+    Buf : destination
+    Max : destination size in samples
+Info:
+    Each step emits the oldest head among the rings. A device with an empty
+    ring may still push a sample as old as its Watermark, so nothing newer
+    than that is emitted until it catches up. The watermark is loaded
+    before the ring, so a sample pushed in between is never missed.
+    Return the number of samples copied
+******************************************************************************/
+UDOUBLE ADS1263_Multi_Read(ADS1263_MULTI *Multi, ADS1263_MULTI_SAMPLE *Buf, UDOUBLE Max)
+{
+    ADS1263_SAMPLE *Head, *Best = NULL;
+    uint64_t Limit, Mark;
+    UDOUBLE Count;
+    UBYTE i, Dev = 0;
+
+    for(Count = 0; Count < Max; Count++) {
+        Best = NULL;
+        Limit = UINT64_MAX;
+        for(i = 0; i < Multi->Number; i++) {
+            Mark = atomic_load_explicit(&Multi->Stream[i].Watermark, memory_order_acquire);
+            if(ADS1263_Stream_Peek(&Multi->Stream[i], &Head) == 0) {
+                if(Mark < Limit)
+                    Limit = Mark;
+            } else if(Best == NULL || Head->Time_ns < Best->Time_ns) {
+                Best = Head;
+                Dev = i;
+            }
+        }
+        if(Best == NULL || Best->Time_ns > Limit)
+            break;
+        Buf[Count].Sample = *Best;
+        Buf[Count].Device = Dev;
+        ADS1263_Stream_Release(&Multi->Stream[Dev], 1);
+    }
+    return Count;
+}
+
+/******************************************************************************
+function:   Conversions lost to full rings, all devices together
+parameter:
+Info:
+******************************************************************************/
+UDOUBLE ADS1263_Multi_Dropped(ADS1263_MULTI *Multi)
+{
+    UDOUBLE Total = 0;
+    UBYTE i;
+    for(i = 0; i < Multi->Number; i++)
+        Total += ADS1263_Stream_Dropped(&Multi->Stream[i]);
+    return Total;
+}
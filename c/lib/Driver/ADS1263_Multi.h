@@ -0,0 +1,57 @@
+/*****************************************************************************
+* | File        :   ADS1263_Multi.h
+* | Author      :   Waveshare team
+* | Function    :   Parallel acquisition on several ADS1263
+* | Info        :
+*   One ADS1263_Stream per device, merged in DRDY time order
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_MULTI_H_
+#define _ADS1263_MULTI_H_
+
+#include "ADS1263_Stream.h"
+
+#define ADS1263_MULTI_MAXDEV    4       // one per core on a Pi
+
+typedef struct {
+    ADS1263_SAMPLE Sample;
+    UBYTE Device;                       // order of ADS1263_Multi_Add, from 0
+} ADS1263_MULTI_SAMPLE;
+
+typedef struct {
+    ADS1263_STREAM Stream[ADS1263_MULTI_MAXDEV];
+    UBYTE Number;
+    UDOUBLE Size;                       // ring capacity of each device
+} ADS1263_MULTI;
+
+void ADS1263_Multi_Init(ADS1263_MULTI *Multi, UDOUBLE Size);
+UBYTE ADS1263_Multi_Add(ADS1263_MULTI *Multi, ADS1263_DEVICE *Dev, const UBYTE *List, UBYTE Number, int CPU);
+void ADS1263_Multi_Stop(ADS1263_MULTI *Multi);
+void ADS1263_Multi_Free(ADS1263_MULTI *Multi);
+
+UDOUBLE ADS1263_Multi_Read(ADS1263_MULTI *Multi, ADS1263_MULTI_SAMPLE *Buf, UDOUBLE Max);
+UDOUBLE ADS1263_Multi_Dropped(ADS1263_MULTI *Multi);
+
+#endif
@@ -0,0 +1,177 @@
+/*****************************************************************************
+* | File        :   ADS1263_RTD.c
+* | Author      :   Waveshare team
+* | Function    :   Multi-channel RTD scanning and linearisation
+* | Info        :
+*   RTD channels run as one scan plan, codes turn into ohms and
+*   degrees Celsius through a Callendar-Van Dusen lookup table
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "ADS1263_RTD.h"
+#include <pthread.h>
+
+/* IEC 60751 platinum, alpha = 0.00385 */
+#define RTD_A   3.9083e-3
+#define RTD_B   -5.775e-7
+#define RTD_C   -4.183e-12
+
+#define RTD_STEP    ((ADS1263_RTD_RATIO_MAX - ADS1263_RTD_RATIO_MIN) / ADS1263_RTD_LUT)
+
+/* temperature at evenly spaced R/R0, filled once by ADS1263_RTD_LutInit */
+static float ADS1263_RTD_Lut[ADS1263_RTD_LUT + 1];
+static pthread_once_t ADS1263_RTD_LutOnce = PTHREAD_ONCE_INIT;
+
+/******************************************************************************
+function:   Invert Callendar-Van Dusen at each table point
+parameter:
+Info:
+    Newton from the linear estimate settles in a few steps; the curve is
+    smooth enough that linear interpolation between points costs under
+    0.001 C.
+******************************************************************************/
+static void ADS1263_RTD_LutInit(void)
+{
+    double r, t, f, d;
+    int i, n;
+    for(i = 0; i <= ADS1263_RTD_LUT; i++) {
+        r = ADS1263_RTD_RATIO_MIN + i * RTD_STEP;
+        t = (r - 1.0) / RTD_A;
+        for(n = 0; n < 8; n++) {
+            f = 1.0 + RTD_A * t + RTD_B * t * t - r;
+            d = RTD_A + 2.0 * RTD_B * t;
+            if(t < 0) {
+                f += RTD_C * (t - 100.0) * t * t * t;
+                d += RTD_C * (4.0 * t - 300.0) * t * t;
+            }
+            t -= f / d;
+        }
+        ADS1263_RTD_Lut[i] = (float)t;
+    }
+}
+
+/******************************************************************************
+function:   Platinum RTD temperature
+parameter:
+    Ratio : R / R0
+Info:
+    Outside the table the end points are returned.
+    Return degrees Celsius
+******************************************************************************/
+float ADS1263_RTD_Temp(float Ratio)
+{
+    float x;
+    int i;
+    pthread_once(&ADS1263_RTD_LutOnce, ADS1263_RTD_LutInit);
+    x = (Ratio - (float)ADS1263_RTD_RATIO_MIN) * (float)(1.0 / RTD_STEP);
+    if(!(x > 0.0f))
+        return ADS1263_RTD_Lut[0];
+    if(x >= ADS1263_RTD_LUT)
+        return ADS1263_RTD_Lut[ADS1263_RTD_LUT];
+    i = (int)x;
+    x -= i;
+    return ADS1263_RTD_Lut[i] + (ADS1263_RTD_Lut[i + 1] - ADS1263_RTD_Lut[i]) * x;
+}
+
+/******************************************************************************
+function:   Compile RTD channels into a scan
+parameter:
+    Scan    : receives the plan and the conversion factors
+    Channel : Number RTD definitions, up to ADS1263_SCAN_MAXSTEP
+Info:
+    ADC1 must already be set up; the PGA gain is taken from the register
+    shadow. Excitation and reference are only rewritten between RTDs that
+    differ in them, so RTDs sharing one current source cost a mux write
+    per reading. Give ADS1263_ConfigureADC1 a conversion delay that
+    covers IDAC settling if they do not.
+    Return 0 success, 1 bad channel
+******************************************************************************/
+UBYTE ADS1263_RTDScan_Build(ADS1263_DEVICE *Dev, ADS1263_RTD_SCAN *Scan, const ADS1263_RTD_CHANNEL *Channel, UBYTE Number)
+{
+    ADS1263_SCAN_ENTRY Entry[ADS1263_SCAN_MAXSTEP];
+    UBYTE MODE2 = ADS1263_GetReg(Dev, REG_MODE2), i;
+    double Gain = (MODE2 & 0x80) ? 1.0 : (double)(1U << ((MODE2 >> 4) & 0x07));
+
+    if(Number == 0 || Number > ADS1263_SCAN_MAXSTEP) {
+        return 1;
+    }
+    for(i = 0; i < Number; i++) {
+        if(!(Channel[i].R0 > 0.0f)) {
+            return 1;
+        }
+        Entry[i].Type = ADS1263_SCAN_RTD;
+        Entry[i].Channel = Channel[i].Positive;
+        Entry[i].Negative = Channel[i].Negative;
+        Entry[i].IDACMUX = Channel[i].IDACMUX;
+        Entry[i].IDACMAG = Channel[i].IDACMAG;
+        Entry[i].REFMUX = Channel[i].REFMUX;
+        Scan->Scale[i] = (float)(Channel[i].RRef * Channel[i].Ratio / Gain / 2147483648.0);
+        Scan->InvR0[i] = 1.0f / Channel[i].R0;
+    }
+    if(ADS1263_ScanPlan_Build(Dev, &Scan->Plan, Entry, Number) != 0) {
+        return 1;
+    }
+    Scan->Number = Number;
+    return 0;
+}
+
+/******************************************************************************
+function:   Convert one scan's codes
+parameter:
+    Code : Scan->Number codes in channel order
+    Res  : receives ohms, may be NULL
+    Temp : receives degrees Celsius, may be NULL
+Info:
+******************************************************************************/
+void ADS1263_RTD_ToTemp(const ADS1263_RTD_SCAN *Scan, const UDOUBLE *Code, float *Res, float *Temp)
+{
+    float R;
+    UBYTE i;
+    for(i = 0; i < Scan->Number; i++) {
+        R = (float)(int32_t)Code[i] * Scan->Scale[i];
+        if(Res != NULL)
+            Res[i] = R;
+        if(Temp != NULL)
+            Temp[i] = ADS1263_RTD_Temp(R * Scan->InvR0[i]);
+    }
+}
+
+/******************************************************************************
+function:   Read every RTD of a scan once
+parameter:
+    Res  : receives Scan->Number resistances, may be NULL
+    Temp : receives Scan->Number temperatures, may be NULL
+Info:
+    ADC1 keeps converting between runs, see ADS1263_ScanPlan_Run.
+    Return 0 success, 1 some reading timed out and reads 0 ohms
+******************************************************************************/
+UBYTE ADS1263_RTDScan_Run(ADS1263_DEVICE *Dev, const ADS1263_RTD_SCAN *Scan, float *Res, float *Temp)
+{
+    UDOUBLE Code[ADS1263_SCAN_MAXSTEP];
+    UBYTE err;
+
+    err = ADS1263_ScanPlan_Run(Dev, &Scan->Plan, Code);
+    ADS1263_RTD_ToTemp(Scan, Code, Res, Temp);
+    return err;
+}
@@ -0,0 +1,68 @@
+/*****************************************************************************
+* | File        :   ADS1263_RTD.h
+* | Author      :   Waveshare team
+* | Function    :   Multi-channel RTD scanning and linearisation
+* | Info        :
+*   RTD channels run as one scan plan, codes turn into ohms and
+*   degrees Celsius through a Callendar-Van Dusen lookup table
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_RTD_H_
+#define _ADS1263_RTD_H_
+
+#include "ADS1263_Scan.h"
+
+#define ADS1263_RTD_LUT         512         // table intervals
+#define ADS1263_RTD_RATIO_MIN   0.18        // R/R0 at the ends of the table,
+#define ADS1263_RTD_RATIO_MAX   3.92        // about -200 and 855 C for platinum
+
+/**
+ * One RTD, measured ratiometrically against a reference resistor
+ * carrying the excitation current
+**/
+typedef struct {
+    UBYTE Positive;     // INPMUX positive input across the RTD, 0-15
+    UBYTE Negative;     // INPMUX negative input
+    UBYTE IDACMUX;      // REG_IDACMUX, IDAC2 pin << 4 | IDAC1 pin
+    UBYTE IDACMAG;      // REG_IDACMAG, IDAC2 << 4 | IDAC1 current
+    UBYTE REFMUX;       // REG_REFMUX, the inputs across the reference resistor
+    float RRef;         // reference resistor, ohms
+    float Ratio;        // reference current / RTD current, 2.0 with both IDACs through RRef
+    float R0;           // RTD at 0 C, 100 for PT100, 1000 for PT1000
+} ADS1263_RTD_CHANNEL;
+
+typedef struct {
+    ADS1263_SCAN_PLAN Plan;
+    float Scale[ADS1263_SCAN_MAXSTEP];      // ohms per code, gain applied
+    float InvR0[ADS1263_SCAN_MAXSTEP];
+    UBYTE Number;
+} ADS1263_RTD_SCAN;
+
+UBYTE ADS1263_RTDScan_Build(ADS1263_DEVICE *Dev, ADS1263_RTD_SCAN *Scan, const ADS1263_RTD_CHANNEL *Channel, UBYTE Number);
+UBYTE ADS1263_RTDScan_Run(ADS1263_DEVICE *Dev, const ADS1263_RTD_SCAN *Scan, float *Res, float *Temp);
+void ADS1263_RTD_ToTemp(const ADS1263_RTD_SCAN *Scan, const UDOUBLE *Code, float *Res, float *Temp);
+float ADS1263_RTD_Temp(float Ratio);
+
+#endif
@@ -0,0 +1,280 @@
+/*****************************************************************************
+* | File        :   ADS1263_Scan.c
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 precompiled scan sequences
+* | Info        :
+*   A scan plan is built once from a channel list; running it only sends
+*   the register frames that differ from the previous step.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "ADS1263_Scan.h"
+#include <time.h>
+
+/* IDAC outputs off, as after reset */
+#define ADS1263_IDACMUX_OFF 0xBB
+#define ADS1263_IDACMAG_OFF 0x00
+
+/******************************************************************************
+function:   Build a scan plan
+parameter:
+    Plan   : plan to fill
+    List   : channel list, mixed types allowed
+    Number : list length, 1 to ADS1263_SCAN_MAXSTEP
+Info:
+    The mux and excitation bytes and their WREG frames are computed here,
+    together with which of them change from one step to the next (the
+    last step wraps to the first). Non-RTD steps in a plan with RTD
+    entries switch the IDACs off and restore the REFMUX value found now.
+    Return 0 success, 1 bad list
+******************************************************************************/
+UBYTE ADS1263_ScanPlan_Build(ADS1263_DEVICE *Dev, ADS1263_SCAN_PLAN *Plan, const ADS1263_SCAN_ENTRY *List, UBYTE Number)
+{
+    ADS1263_SCAN_STEP *Step, *Prev;
+    UBYTE i, INPMUX, REFMUX = 0;
+
+    if(Number == 0 || Number > ADS1263_SCAN_MAXSTEP) {
+        return 1;
+    }
+    Plan->Number = 0;
+    Plan->UseExc = 0;
+    for(i = 0; i < Number; i++) {
+        if(List[i].Type == ADS1263_SCAN_RTD)
+            Plan->UseExc = 1;
+    }
+    if(Plan->UseExc)
+        REFMUX = ADS1263_GetReg(Dev, REG_REFMUX);
+
+    for(i = 0; i < Number; i++) {
+        switch(List[i].Type) {
+        case ADS1263_SCAN_SINGLE:
+            if(List[i].Channel > 10)
+                return 1;
+            INPMUX = (List[i].Channel << 4) | 0x0a;     //0x0a:VCOM as Negative Input
+            break;
+        case ADS1263_SCAN_DIFF:
+            if(List[i].Channel > 4)
+                return 1;
+            INPMUX = ((List[i].Channel * 2) << 4) | (List[i].Channel * 2 + 1);
+            break;
+        case ADS1263_SCAN_MUX:
+        case ADS1263_SCAN_RTD:
+            if(List[i].Channel > 15 || List[i].Negative > 15)
+                return 1;
+            INPMUX = (List[i].Channel << 4) | List[i].Negative;
+            break;
+        default:
+            return 1;
+        }
+
+        Step = &Plan->Step[i];
+        Step->Channel = List[i].Channel;
+        Step->MuxFrame[0] = CMD_WREG | REG_INPMUX;
+        Step->MuxFrame[1] = 0x00;
+        Step->MuxFrame[2] = INPMUX;
+        Step->ExcFrame[0] = CMD_WREG | REG_IDACMUX;
+        Step->ExcFrame[1] = 0x02;                       // 3 registers
+        if(List[i].Type == ADS1263_SCAN_RTD) {
+            Step->ExcFrame[2] = List[i].IDACMUX;
+            Step->ExcFrame[3] = List[i].IDACMAG;
+            Step->ExcFrame[4] = List[i].REFMUX;
+        } else {
+            Step->ExcFrame[2] = ADS1263_IDACMUX_OFF;
+            Step->ExcFrame[3] = ADS1263_IDACMAG_OFF;
+            Step->ExcFrame[4] = REFMUX;
+        }
+    }
+
+    for(i = 0; i < Number; i++) {
+        Step = &Plan->Step[i];
+        Prev = &Plan->Step[i == 0 ? Number - 1 : i - 1];
+        Step->WriteMux = Step->MuxFrame[2] != Prev->MuxFrame[2];
+        Step->WriteExc = Plan->UseExc && memcmp(&Step->ExcFrame[2], &Prev->ExcFrame[2], 3) != 0;
+    }
+    Plan->Number = Number;
+    return 0;
+}
+
+/******************************************************************************
+function:   Select pipelined scanning
+parameter:
+    Enable : 1 program the next step between DRDY and the readout,
+             0 program, wait, read strictly in turn
+Info:
+    Applies to every plan run on Dev, including the one behind ADS1263_GetAll
+******************************************************************************/
+void ADS1263_ScanPlan_SetPipeline(ADS1263_DEVICE *Dev, UBYTE Enable)
+{
+    Dev->Pipeline = Enable ? 1 : 0;
+}
+
+static uint64_t ADS1263_Scan_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* queue the frames that move the chip to Step, see ADS1263_Chain_Run */
+static void ADS1263_Scan_Program(ADS1263_CHAIN *Chain, const ADS1263_SCAN_STEP *Step)
+{
+    if(Step->WriteExc)
+        ADS1263_Chain_WriteRegFrame(Chain, Step->ExcFrame, sizeof(Step->ExcFrame));
+    if(Step->WriteMux)
+        ADS1263_Chain_WriteRegFrame(Chain, Step->MuxFrame, sizeof(Step->MuxFrame));
+}
+
+/******************************************************************************
+function:   Bring the chip to the first step of a plan
+parameter:
+Info:
+    Step frames are deltas against the step before, so wherever the last
+    run or another caller left the mux, step 0 is written in full, and
+    only when the shadow says it differs.
+******************************************************************************/
+static void ADS1263_Scan_Sync(ADS1263_DEVICE *Dev, const ADS1263_SCAN_PLAN *Plan)
+{
+    const ADS1263_SCAN_STEP *Step = Plan->Step;
+    if(Plan->UseExc && (ADS1263_GetReg(Dev, REG_IDACMUX) != Step->ExcFrame[2]
+        || ADS1263_GetReg(Dev, REG_IDACMAG) != Step->ExcFrame[3]
+        || ADS1263_GetReg(Dev, REG_REFMUX) != Step->ExcFrame[4]))
+        ADS1263_WriteRegFrame(Dev, Step->ExcFrame, sizeof(Step->ExcFrame));
+    if(ADS1263_GetReg(Dev, REG_INPMUX) != Step->MuxFrame[2])
+        ADS1263_WriteRegFrame(Dev, Step->MuxFrame, sizeof(Step->MuxFrame));
+}
+
+/******************************************************************************
+function:   Pipelined plan run
+parameter:
+Info:
+    At each DRDY the next step is written first, which restarts the
+    converter on the next input, and the latched result is read while
+    the new conversion settles. The readout has to finish inside the
+    restart window (MODE0 delay + filter latency, ADS1263_GetSettle_us),
+    or it may pick up the next step's data: such samples are flagged
+    ADS1263_SAMPLE_LATE and the following steps read before they write
+    until the readout fits again. The last step arms the first one, so
+    back-to-back runs stay pipelined. Either way the step's frames and
+    the readout share one chip select, one ioctl on spidev.
+******************************************************************************/
+static UBYTE ADS1263_ScanPlan_RunPipelined(ADS1263_DEVICE *Dev, const ADS1263_SCAN_PLAN *Plan, ADS1263_SAMPLE *Sample)
+{
+    const ADS1263_SCAN_STEP *Step = Plan->Step, *Next;
+    uint64_t Window_ns = (uint64_t)ADS1263_GetSettle_us(Dev) * 1000, t0;
+    ADS1263_CHAIN Chain;
+    UBYTE i, err = 0;
+
+    ADS1263_Scan_Sync(Dev, Plan);
+    ADS1263_Chain_Init(&Chain);
+
+    for(i = 0; i < Plan->Number; i++, Step++) {
+        Next = (i + 1 == Plan->Number) ? Plan->Step : Step + 1;
+        if(ADS1263_WaitSample(Dev, &Sample[i]) != 0) {
+            ADS1263_Scan_Program(&Chain, Next);
+            ADS1263_Chain_Run(Dev, &Chain);
+            Sample[i].Channel = Step->Channel;
+            err = 1;
+            continue;
+        }
+
+        t0 = ADS1263_Scan_Now();
+        if(Dev->Readout_ns < Window_ns) {
+            ADS1263_Scan_Program(&Chain, Next);
+            ADS1263_Chain_ReadFrame(&Chain, &Sample[i]);
+            ADS1263_Chain_Run(Dev, &Chain);
+            Dev->Readout_ns = ADS1263_Scan_Now() - t0;
+            if(Dev->Readout_ns >= Window_ns)
+                Sample[i].Flags |= ADS1263_SAMPLE_LATE;
+        } else {
+            ADS1263_Chain_ReadFrame(&Chain, &Sample[i]);
+            ADS1263_Scan_Program(&Chain, Next);
+            ADS1263_Chain_Run(Dev, &Chain);
+            Dev->Readout_ns = ADS1263_Scan_Now() - t0;
+        }
+        if(Sample[i].Flags & ADS1263_SAMPLE_TIMEOUT)
+            err = 1;
+        Sample[i].Channel = Step->Channel;
+    }
+    return err;
+}
+
+/******************************************************************************
+function:   Run a scan plan once
+parameter:
+    Plan   : built plan
+    Sample : Plan->Number samples, one per step
+Info:
+    The first step is brought in through the register shadow, so nothing
+    is written if the chip is already there; every later step only sends
+    its precomputed frames. See ADS1263_ScanPlan_SetPipeline.
+    Each readout and the frames for the following step go out as one
+    chain, so a step costs one transaction besides its DRDY wait. Such a
+    readout is not retried (ADS1263_Chain_Run): a frame without new
+    data is flagged ADS1263_SAMPLE_TIMEOUT rather than read again after
+    the mux has moved on.
+    Return 0 success, 1 some step timed out (ADS1263_SAMPLE_TIMEOUT)
+******************************************************************************/
+UBYTE ADS1263_ScanPlan_RunSamples(ADS1263_DEVICE *Dev, const ADS1263_SCAN_PLAN *Plan, ADS1263_SAMPLE *Sample)
+{
+    const ADS1263_SCAN_STEP *Step = Plan->Step;
+    ADS1263_CHAIN Chain;
+    UBYTE i, err = 0;
+
+    if(Dev->Pipeline && Plan->Number > 1) {
+        return ADS1263_ScanPlan_RunPipelined(Dev, Plan, Sample);
+    }
+    ADS1263_Scan_Sync(Dev, Plan);
+    ADS1263_Chain_Init(&Chain);
+
+    for(i = 0; i < Plan->Number; i++, Step++) {
+        if(ADS1263_WaitSample(Dev, &Sample[i]) == 0)
+            ADS1263_Chain_ReadFrame(&Chain, &Sample[i]);
+        if(i + 1 < Plan->Number)
+            ADS1263_Scan_Program(&Chain, Step + 1);
+        ADS1263_Chain_Run(Dev, &Chain);
+        if(Sample[i].Flags & ADS1263_SAMPLE_TIMEOUT)
+            err = 1;
+        Sample[i].Channel = Step->Channel;
+    }
+    return err;
+}
+
+/******************************************************************************
+function:   Run a scan plan once, codes only
+parameter:
+    Plan  : built plan
+    Value : Plan->Number codes; a timed-out step reads 0
+Info:   Return 0 success, 1 some step timed out
+******************************************************************************/
+UBYTE ADS1263_ScanPlan_Run(ADS1263_DEVICE *Dev, const ADS1263_SCAN_PLAN *Plan, UDOUBLE *Value)
+{
+    ADS1263_SAMPLE Sample[ADS1263_SCAN_MAXSTEP];
+    UBYTE i, err;
+
+    err = ADS1263_ScanPlan_RunSamples(Dev, Plan, Sample);
+    for(i = 0; i < Plan->Number; i++) {
+        Value[i] = Sample[i].Value;
+    }
+    return err;
+}
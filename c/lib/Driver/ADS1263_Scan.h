@@ -0,0 +1,44 @@
+/*****************************************************************************
+* | File        :   ADS1263_Scan.h
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 precompiled scan sequences
+* | Info        :
+*   A scan plan is built once from a channel list; running it only sends
+*   the register frames that differ from the previous step.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_SCAN_H_
+#define _ADS1263_SCAN_H_
+
+#include "ADS1263.h"
+
+/* the plan types are in ADS1263.h, ADS1263_DEVICE holds the ADS1263_GetAll plan */
+
+UBYTE ADS1263_ScanPlan_Build(ADS1263_DEVICE *Dev, ADS1263_SCAN_PLAN *Plan, const ADS1263_SCAN_ENTRY *List, UBYTE Number);
+UBYTE ADS1263_ScanPlan_Run(ADS1263_DEVICE *Dev, const ADS1263_SCAN_PLAN *Plan, UDOUBLE *Value);
+UBYTE ADS1263_ScanPlan_RunSamples(ADS1263_DEVICE *Dev, const ADS1263_SCAN_PLAN *Plan, ADS1263_SAMPLE *Sample);
+void ADS1263_ScanPlan_SetPipeline(ADS1263_DEVICE *Dev, UBYTE Enable);
+
+#endif
@@ -0,0 +1,254 @@
+/*****************************************************************************
+* | File        :   ADS1263_Stats.c
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 hot-path statistics
+* | Info        :
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "ADS1263_Stats.h"
+#include "Debug.h"
+#include <string.h>
+#include <pthread.h>
+
+/* ticks to ns: (ticks * Mult) >> STATS_SHIFT, holds for deltas of hours */
+#define STATS_SHIFT     20
+/* TSC rate measured against CLOCK_MONOTONIC_RAW over this long */
+#define STATS_CAL_NS    10000000
+
+/* make USDT=1: one probe per recorded stage and counter, for perf or bpftrace */
+#if defined(ADS1263_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define STATS_PROBE_STAGE(Stats, Stage, ns)     DTRACE_PROBE3(ads1263, stage, Stats, Stage, ns)
+#define STATS_PROBE_COUNT(Stats, Counter)       DTRACE_PROBE2(ads1263, count, Stats, Counter)
+#endif
+#endif
+#ifndef STATS_PROBE_STAGE
+#define STATS_PROBE_STAGE(Stats, Stage, ns)
+#define STATS_PROBE_COUNT(Stats, Counter)
+#endif
+
+static uint64_t ADS1263_Stats_Hz;
+static pthread_once_t ADS1263_Stats_HzOnce = PTHREAD_ONCE_INIT;
+
+static uint64_t ADS1263_Stats_Mono(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/******************************************************************************
+function:   Find the rate of ADS1263_Stats_Now
+parameter:
+Info:
+    aarch64 has it in CNTFRQ_EL0; the TSC is timed against the
+    monotonic clock once per process.
+******************************************************************************/
+static void ADS1263_Stats_HzInit(void)
+{
+#if defined(__aarch64__)
+    uint64_t f;
+    __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(f));
+    ADS1263_Stats_Hz = f;
+#elif defined(__x86_64__) || defined(__i386__)
+    uint64_t m0, m1, t0, t1;
+    m0 = ADS1263_Stats_Mono();
+    t0 = ADS1263_Stats_Now();
+    do {
+        m1 = ADS1263_Stats_Mono();
+    } while(m1 - m0 < STATS_CAL_NS);
+    t1 = ADS1263_Stats_Now();
+    ADS1263_Stats_Hz = (t1 - t0) * 1000000000ULL / (m1 - m0);
+#else
+    ADS1263_Stats_Hz = 1000000000ULL;
+#endif
+    if(ADS1263_Stats_Hz == 0)
+        ADS1263_Stats_Hz = 1000000000ULL;
+    Log_Debug("ADS1263_Stats: %llu ticks/s\r\n", (unsigned long long)ADS1263_Stats_Hz);
+}
+
+/******************************************************************************
+function:   Start from zero
+parameter:
+    Stats : block to clear
+Info:
+    Not while the block is attached to a running device; the first call
+    in a process may take 10 ms to time the counter.
+******************************************************************************/
+void ADS1263_Stats_Init(ADS1263_STATS *Stats)
+{
+    UBYTE i;
+    pthread_once(&ADS1263_Stats_HzOnce, ADS1263_Stats_HzInit);
+    memset(Stats, 0, sizeof(*Stats));
+    atomic_init(&Stats->Seq, 0);
+    for(i = 0; i < ADS1263_STAGE_NUM; i++)
+        Stats->Data.Stage[i].Min_ns = UINT64_MAX;
+    Stats->Data.Tick_Hz = ADS1263_Stats_Hz;
+    Stats->Mult = (1000000000ULL << STATS_SHIFT) / ADS1263_Stats_Hz;
+}
+
+/* the writer side of the sequence lock; there is only ever one writer */
+static inline void ADS1263_Stats_Lock(ADS1263_STATS *Stats)
+{
+    unsigned Seq = atomic_load_explicit(&Stats->Seq, memory_order_relaxed);
+    atomic_store_explicit(&Stats->Seq, Seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static inline void ADS1263_Stats_Unlock(ADS1263_STATS *Stats)
+{
+    unsigned Seq = atomic_load_explicit(&Stats->Seq, memory_order_relaxed);
+    atomic_store_explicit(&Stats->Seq, Seq + 1, memory_order_release);
+}
+
+/******************************************************************************
+function:   Account one stage
+parameter:
+    Stats : block to update
+    Stage : which stage ended now
+    Start : ADS1263_Stats_Now when it began
+Info:
+    Called by the driver, see ADS1263_SetStats
+******************************************************************************/
+void ADS1263_Stats_Record(ADS1263_STATS *Stats, ADS1263_STAGE Stage, uint64_t Start)
+{
+    ADS1263_STAGE_STATS *s = &Stats->Data.Stage[Stage];
+    uint64_t ns = ((ADS1263_Stats_Now() - Start) * Stats->Mult) >> STATS_SHIFT;
+    UBYTE b = ns == 0 ? 0 : 64 - __builtin_clzll(ns);
+
+    if(b >= ADS1263_STATS_BUCKETS)
+        b = ADS1263_STATS_BUCKETS - 1;
+    ADS1263_Stats_Lock(Stats);
+    s->Count++;
+    s->Sum_ns += ns;
+    if(ns < s->Min_ns)
+        s->Min_ns = ns;
+    if(ns > s->Max_ns)
+        s->Max_ns = ns;
+    s->Hist[b]++;
+    ADS1263_Stats_Unlock(Stats);
+    STATS_PROBE_STAGE(Stats, Stage, ns);
+}
+
+/******************************************************************************
+function:   Count one event
+parameter:
+    Stats   : block to update
+    Counter : which event
+Info:
+    Called by the driver, see ADS1263_SetStats
+******************************************************************************/
+void ADS1263_Stats_Count(ADS1263_STATS *Stats, ADS1263_COUNTER Counter)
+{
+    ADS1263_Stats_Lock(Stats);
+    Stats->Data.Counter[Counter]++;
+    ADS1263_Stats_Unlock(Stats);
+    STATS_PROBE_COUNT(Stats, Counter);
+}
+
+/******************************************************************************
+function:   Copy the statistics
+parameter:
+    Stats : attached block, may be updated meanwhile by another thread
+    Snap  : receives a copy no update is half way through
+Info:
+    Retries while the driver is updating, which is a few ns at a time
+******************************************************************************/
+void ADS1263_Stats_Snapshot(const ADS1263_STATS *Stats, ADS1263_STATS_SNAPSHOT *Snap)
+{
+    unsigned s0, s1;
+    UBYTE i;
+    do {
+        s0 = atomic_load_explicit((atomic_uint *)&Stats->Seq, memory_order_acquire);
+        memcpy(Snap, &Stats->Data, sizeof(*Snap));
+        atomic_thread_fence(memory_order_acquire);
+        s1 = atomic_load_explicit((atomic_uint *)&Stats->Seq, memory_order_relaxed);
+    } while((s0 & 1) || s0 != s1);
+    for(i = 0; i < ADS1263_STAGE_NUM; i++) {
+        if(Snap->Stage[i].Count == 0)
+            Snap->Stage[i].Min_ns = 0;
+    }
+}
+
+/******************************************************************************
+function:   Latency percentile from the histogram
+parameter:
+    Stage : one stage of a snapshot
+    p     : 0.0 - 1.0
+Info:
+    Return the upper edge of the bucket holding it, at most Max_ns
+******************************************************************************/
+uint64_t ADS1263_Stats_Percentile(const ADS1263_STAGE_STATS *Stage, double p)
+{
+    uint64_t Want, Seen = 0, Edge;
+    UBYTE b;
+
+    if(Stage->Count == 0)
+        return 0;
+    Want = (uint64_t)(p * Stage->Count + 0.5);
+    if(Want == 0)
+        Want = 1;
+    for(b = 0; b < ADS1263_STATS_BUCKETS - 1; b++) {
+        Seen += Stage->Hist[b];
+        if(Seen >= Want)
+            break;
+    }
+    Edge = b == 0 ? 0 : (1ULL << b) - 1;
+    return Edge < Stage->Max_ns ? Edge : Stage->Max_ns;
+}
+
+/******************************************************************************
+function:   Write a snapshot as text
+parameter:
+    fp   : stdout, a log file, ...
+    Snap : from ADS1263_Stats_Snapshot
+Info:
+    One line per stage, then one per counter, all times in ns; the
+    percentiles are bucket edges, see ADS1263_Stats_Percentile.
+******************************************************************************/
+void ADS1263_Stats_Print(FILE *fp, const ADS1263_STATS_SNAPSHOT *Snap)
+{
+    static const char *StageName[ADS1263_STAGE_NUM] = {"wait", "mux", "read", "crc"};
+    static const char *CountName[ADS1263_COUNT_NUM] = {"samples", "retries", "crc_errors", "timeouts"};
+    const ADS1263_STAGE_STATS *s;
+    UBYTE i;
+
+    fprintf(fp, "%-6s %10s %10s %10s %10s %10s %10s\r\n",
+        "stage", "count", "mean", "min", "p50", "p99", "max");
+    for(i = 0; i < ADS1263_STAGE_NUM; i++) {
+        s = &Snap->Stage[i];
+        fprintf(fp, "%-6s %10llu %10llu %10llu %10llu %10llu %10llu\r\n", StageName[i],
+            (unsigned long long)s->Count,
+            (unsigned long long)(s->Count ? s->Sum_ns / s->Count : 0),
+            (unsigned long long)s->Min_ns,
+            (unsigned long long)ADS1263_Stats_Percentile(s, 0.5),
+            (unsigned long long)ADS1263_Stats_Percentile(s, 0.99),
+            (unsigned long long)s->Max_ns);
+    }
+    for(i = 0; i < ADS1263_COUNT_NUM; i++) {
+        fprintf(fp, "%-10s %llu\r\n", CountName[i], (unsigned long long)Snap->Counter[i]);
+    }
+}
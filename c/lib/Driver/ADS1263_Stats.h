@@ -0,0 +1,125 @@
+/*****************************************************************************
+* | File        :   ADS1263_Stats.h
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 hot-path statistics
+* | Info        :
+*   Per-stage latency histograms and event counters, filled by the driver
+*   while a statistics block is attached with ADS1263_SetStats
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_STATS_H_
+#define _ADS1263_STATS_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "DEV_Config.h"
+
+/* make STATS=0 compiles the driver hooks out */
+#ifndef ADS1263_USE_STATS
+#define ADS1263_USE_STATS 1
+#endif
+
+#define ADS1263_STATS_BUCKETS   32      // bucket n >= 1 holds [2^(n-1), 2^n) ns, the last one everything above
+
+/**
+ * Timed stages of one conversion
+**/
+typedef enum {
+    ADS1263_STAGE_WAIT = 0,     // DRDY wait
+    ADS1263_STAGE_MUX,          // mux write and read-back, or a chain holding no readout
+    ADS1263_STAGE_READ,         // RDATA transfer, retries included, or a chain carrying one
+    ADS1263_STAGE_CRC,          // checksum of a data frame
+    ADS1263_STAGE_NUM,
+} ADS1263_STAGE;
+
+typedef enum {
+    ADS1263_COUNT_SAMPLE = 0,   // data frames decoded, ADC1 and ADC2
+    ADS1263_COUNT_RETRY,        // RDATA transfers repeated because no new data was flagged
+    ADS1263_COUNT_CRC,          // data frames with a checksum mismatch
+    ADS1263_COUNT_TIMEOUT,      // DRDY waits that timed out
+    ADS1263_COUNT_NUM,
+} ADS1263_COUNTER;
+
+typedef struct {
+    uint64_t Count;
+    uint64_t Sum_ns;
+    uint64_t Min_ns;            // 0 while Count is 0
+    uint64_t Max_ns;
+    uint64_t Hist[ADS1263_STATS_BUCKETS];
+} ADS1263_STAGE_STATS;
+
+/**
+ * A consistent copy of an ADS1263_STATS, see ADS1263_Stats_Snapshot.
+ * Everything counts up from ADS1263_Stats_Init, subtract two
+ * snapshots for an interval.
+**/
+typedef struct {
+    ADS1263_STAGE_STATS Stage[ADS1263_STAGE_NUM];
+    uint64_t Counter[ADS1263_COUNT_NUM];
+    uint64_t Tick_Hz;           // timestamp counter the stages were measured with
+} ADS1263_STATS_SNAPSHOT;
+
+/**
+ * Written only by the thread driving the device, read from anywhere
+ * through ADS1263_Stats_Snapshot
+**/
+typedef struct {
+    atomic_uint Seq;            // odd while an update is in progress
+    uint64_t Mult;              // ns per tick, 20 fractional bits
+    ADS1263_STATS_SNAPSHOT Data;
+} ADS1263_STATS;
+
+/******************************************************************************
+function:   Read the timestamp counter
+parameter:
+Info:
+    The generic timer on aarch64 and the TSC on x86 are read without a
+    system call; elsewhere CLOCK_MONOTONIC_RAW in ns.
+******************************************************************************/
+static inline uint64_t ADS1263_Stats_Now(void)
+{
+#if defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#elif defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+void ADS1263_Stats_Init(ADS1263_STATS *Stats);
+void ADS1263_Stats_Record(ADS1263_STATS *Stats, ADS1263_STAGE Stage, uint64_t Start);
+void ADS1263_Stats_Count(ADS1263_STATS *Stats, ADS1263_COUNTER Counter);
+void ADS1263_Stats_Snapshot(const ADS1263_STATS *Stats, ADS1263_STATS_SNAPSHOT *Snap);
+uint64_t ADS1263_Stats_Percentile(const ADS1263_STAGE_STATS *Stage, double p);
+void ADS1263_Stats_Print(FILE *fp, const ADS1263_STATS_SNAPSHOT *Snap);
+
+#endif
@@ -0,0 +1,338 @@
+/*****************************************************************************
+* | File        :   ADS1263_Stream.c
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 continuous-conversion streaming
+* | Info        :
+*   An acquisition thread reads every ADC1 conversion and pushes it into
+*   a single-producer/single-consumer ring, the caller drains it in batches.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#define _GNU_SOURCE
+#include "ADS1263_Stream.h"
+#include <stdlib.h>
+#include <sched.h>
+#include <time.h>
+
+/******************************************************************************
+function:   Acquisition thread
+parameter:
+Info:
+    Sole producer: only this thread advances Head.
+    A full ring drops the new conversion rather than overwrite unread ones.
+    With decimation stages the conversion goes through them first and
+    only their results take a slot.
+    Before each wait the Watermark is raised to the current time: the next
+    conversion is stamped after its DRDY, so it cannot be older than that.
+******************************************************************************/
+static void *ADS1263_Stream_Thread(void *arg)
+{
+    ADS1263_STREAM *Stream = (ADS1263_STREAM *)arg;
+    ADS1263_DEVICE *Dev = Stream->Dev;
+    ADS1263_SAMPLE Scratch, *Slot;
+    UDOUBLE Head, Tail;
+    struct timespec ts;
+    UBYTE i = 0;
+
+    while(atomic_load_explicit(&Stream->Running, memory_order_relaxed)) {
+        clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        atomic_store_explicit(&Stream->Watermark,
+            (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec, memory_order_release);
+
+        // a single channel stays selected, the converter just free-runs
+        if(Stream->Number > 1)
+            ADS1263_SelectChannal(Dev, Stream->List[i]);
+
+        Head = atomic_load_explicit(&Stream->Head, memory_order_relaxed);
+        Tail = atomic_load_explicit(&Stream->Tail, memory_order_acquire);
+        if(Stream->Decim != NULL) {
+            if(ADS1263_ReadSample(Dev, &Scratch) == 0) {
+                Scratch.Channel = Stream->List[i];
+                if(ADS1263_Decim_Push(Stream->Decim, &Scratch, &Scratch)) {
+                    if(Head - Tail > Stream->Mask) {
+                        atomic_fetch_add_explicit(&Stream->Dropped, 1, memory_order_relaxed);
+                    } else {
+                        Stream->Buf[Head & Stream->Mask] = Scratch;
+                        atomic_store_explicit(&Stream->Head, Head + 1, memory_order_release);
+                    }
+                }
+            }
+        } else if(Head - Tail > Stream->Mask) {
+            if(ADS1263_ReadSample(Dev, &Scratch) == 0)
+                atomic_fetch_add_explicit(&Stream->Dropped, 1, memory_order_relaxed);
+        } else {
+            Slot = &Stream->Buf[Head & Stream->Mask];
+            if(ADS1263_ReadSample(Dev, Slot) == 0) {
+                Slot->Channel = Stream->List[i];
+                atomic_store_explicit(&Stream->Head, Head + 1, memory_order_release);
+            }
+        }
+
+        if(++i >= Stream->Number)
+            i = 0;
+    }
+    // nothing more will come, readers may drain the ring
+    atomic_store_explicit(&Stream->Watermark, UINT64_MAX, memory_order_release);
+    return NULL;
+}
+
+/******************************************************************************
+function:   Allocate the sample ring
+parameter:
+    Stream : stream object
+    Size   : capacity in samples, rounded up to a power of two
+Info:
+    Return 0 success, 1 out of memory
+******************************************************************************/
+UBYTE ADS1263_Stream_Init(ADS1263_STREAM *Stream, UDOUBLE Size)
+{
+    UDOUBLE n = 2;
+    while(n < Size && n < 0x80000000u)
+        n <<= 1;
+
+    Stream->Buf = (ADS1263_SAMPLE *)calloc(n, sizeof(ADS1263_SAMPLE));
+    if(Stream->Buf == NULL) {
+        Log_Error("ADS1263_Stream_Init: no memory for %u samples \r\n", n);
+        return 1;
+    }
+    Stream->Mask = n - 1;
+    atomic_init(&Stream->Head, 0);
+    atomic_init(&Stream->Tail, 0);
+    atomic_init(&Stream->Dropped, 0);
+    atomic_init(&Stream->Running, 0);
+    atomic_init(&Stream->Watermark, UINT64_MAX);
+    Stream->Number = 0;
+    Stream->Dev = NULL;
+    Stream->CPU = -1;
+    Stream->Decim = NULL;
+    return 0;
+}
+
+/******************************************************************************
+function:   Release the sample ring
+parameter:
+Info:   Stops the thread first if it is still running
+******************************************************************************/
+void ADS1263_Stream_Free(ADS1263_STREAM *Stream)
+{
+    ADS1263_Stream_Stop(Stream);
+    free(Stream->Buf);
+    Stream->Buf = NULL;
+}
+
+/******************************************************************************
+function:   Check a channel list against the mode set with ADS1263_SetMode
+parameter:
+    List   : channels, 0-10 single-ended, 0-4 differential
+    Number : list length, 1 - ADS1263_STREAM_MAXCH
+Info:   Return 0 success, 1 bad list
+******************************************************************************/
+UBYTE ADS1263_Stream_CheckList(ADS1263_DEVICE *Dev, const UBYTE *List, UBYTE Number)
+{
+    UBYTE i;
+    if(Number == 0 || Number > ADS1263_STREAM_MAXCH)
+        return 1;
+    for(i = 0; i < Number; i++) {
+        if(List[i] > (Dev->ScanMode ? 4 : 10)) {
+            Log_Error("ADS1263_Stream_CheckList: channel %d out of range \r\n", List[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/******************************************************************************
+function:   Start continuous ADC1 conversions and the acquisition thread
+parameter:
+    Stream : initialised stream object
+    Dev    : device to read, initialised with ADS1263_init_ADC1
+    List   : channels to cycle through, as for ADS1263_GetAll
+    Number : list length, 1 keeps one input selected
+Info:
+    Uses the mode set with ADS1263_SetMode. While the stream runs the
+    thread owns Dev: do not call other ADS1263_xxx functions on it.
+    Streams on other devices may run at the same time.
+    Every entry is checked first, see ADS1263_Stream_CheckList.
+    Return 0 success, 1 failed
+******************************************************************************/
+UBYTE ADS1263_Stream_Start(ADS1263_STREAM *Stream, ADS1263_DEVICE *Dev, const UBYTE *List, UBYTE Number)
+{
+    pthread_attr_t Attr;
+    cpu_set_t Set;
+    ADS1263_DECIM *Decim;
+    int ret;
+    UBYTE i;
+    if(Stream->Buf == NULL || atomic_load(&Stream->Running) || ADS1263_Stream_CheckList(Dev, List, Number) != 0) {
+        return 1;
+    }
+    for(i = 0; i < Number; i++)
+        Stream->List[i] = List[i];
+    Stream->Number = Number;
+    Stream->Dev = Dev;
+    atomic_store(&Stream->Head, 0);
+    atomic_store(&Stream->Tail, 0);
+    atomic_store(&Stream->Dropped, 0);
+    atomic_store(&Stream->Watermark, 0);
+    for(Decim = Stream->Decim; Decim != NULL; Decim = Decim->Next)
+        ADS1263_Decim_Reset(Decim);
+
+    if(ADS1263_SelectChannal(Dev, List[0]) != 0) {
+        return 1;
+    }
+    ADS1263_WriteCmd(Dev, CMD_START1);
+
+    pthread_attr_init(&Attr);
+    if(Stream->CPU >= 0) {
+        CPU_ZERO(&Set);
+        CPU_SET(Stream->CPU, &Set);
+        pthread_attr_setaffinity_np(&Attr, sizeof(Set), &Set);
+    }
+    atomic_store(&Stream->Running, 1);
+    ret = pthread_create(&Stream->Thread, &Attr, ADS1263_Stream_Thread, Stream);
+    pthread_attr_destroy(&Attr);
+    if(ret != 0) {
+        atomic_store(&Stream->Running, 0);
+        atomic_store(&Stream->Watermark, UINT64_MAX);
+        Log_Error("ADS1263_Stream_Start: pthread_create failed \r\n");
+        return 1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+function:   Pin the acquisition thread to one core
+parameter:
+    CPU : core number, -1 lets the scheduler choose
+Info:   Takes effect at the next ADS1263_Stream_Start
+******************************************************************************/
+void ADS1263_Stream_SetCPU(ADS1263_STREAM *Stream, int CPU)
+{
+    Stream->CPU = CPU;
+}
+
+/******************************************************************************
+function:   Reduce the stream before it reaches the ring
+parameter:
+    Decim : first stage, set up with ADS1263_Decim_Init; NULL raw samples
+Info:
+    Takes effect at the next ADS1263_Stream_Start; the thread owns the
+    stages while it runs. The ring then holds one result per block and
+    channel, and Dropped counts lost results.
+******************************************************************************/
+void ADS1263_Stream_SetDecim(ADS1263_STREAM *Stream, ADS1263_DECIM *Decim)
+{
+    Stream->Decim = Decim;
+}
+
+/******************************************************************************
+function:   Stop the acquisition thread
+parameter:
+Info:
+    ADC1 is left converting, so ADS1263_GetChannalValue works afterwards.
+    Samples still in the ring can be read after the stop.
+******************************************************************************/
+void ADS1263_Stream_Stop(ADS1263_STREAM *Stream)
+{
+    if(!atomic_load(&Stream->Running))
+        return;
+    atomic_store(&Stream->Running, 0);
+    pthread_join(Stream->Thread, NULL);
+}
+
+/******************************************************************************
+function:   Copy out up to Max samples
+parameter:
+    Buf : destination
+    Max : destination size in samples
+Info:   Return the number of samples copied, 0 if the ring is empty
+******************************************************************************/
+UDOUBLE ADS1263_Stream_Read(ADS1263_STREAM *Stream, ADS1263_SAMPLE *Buf, UDOUBLE Max)
+{
+    UDOUBLE Count, i;
+    ADS1263_SAMPLE *Batch;
+
+    for(Count = 0; Count < Max; Count += i) {
+        i = ADS1263_Stream_Peek(Stream, &Batch);
+        if(i == 0)
+            break;
+        if(i > Max - Count)
+            i = Max - Count;
+        memcpy(&Buf[Count], Batch, i * sizeof(ADS1263_SAMPLE));
+        ADS1263_Stream_Release(Stream, i);
+    }
+    return Count;
+}
+
+/******************************************************************************
+function:   Borrow the oldest contiguous run of samples without copying
+parameter:
+    Batch : set to the first sample of the run
+Info:
+    The run ends at the ring wrap, so a second Peek may return more.
+    The samples stay valid until ADS1263_Stream_Release.
+    Return the run length
+******************************************************************************/
+UDOUBLE ADS1263_Stream_Peek(ADS1263_STREAM *Stream, ADS1263_SAMPLE **Batch)
+{
+    UDOUBLE Tail = atomic_load_explicit(&Stream->Tail, memory_order_relaxed);
+    UDOUBLE Head = atomic_load_explicit(&Stream->Head, memory_order_acquire);
+    UDOUBLE Count = Head - Tail;
+    UDOUBLE ToEnd = Stream->Mask + 1 - (Tail & Stream->Mask);
+
+    *Batch = &Stream->Buf[Tail & Stream->Mask];
+    return Count < ToEnd ? Count : ToEnd;
+}
+
+/******************************************************************************
+function:   Hand borrowed samples back to the producer
+parameter:
+    Count : samples consumed, at most what Peek returned
+Info:
+******************************************************************************/
+void ADS1263_Stream_Release(ADS1263_STREAM *Stream, UDOUBLE Count)
+{
+    UDOUBLE Tail = atomic_load_explicit(&Stream->Tail, memory_order_relaxed);
+    atomic_store_explicit(&Stream->Tail, Tail + Count, memory_order_release);
+}
+
+/******************************************************************************
+function:   Samples waiting in the ring
+parameter:
+Info:
+******************************************************************************/
+UDOUBLE ADS1263_Stream_Available(ADS1263_STREAM *Stream)
+{
+    return atomic_load_explicit(&Stream->Head, memory_order_acquire)
+        - atomic_load_explicit(&Stream->Tail, memory_order_relaxed);
+}
+
+/******************************************************************************
+function:   Conversions lost because the ring was full
+parameter:
+Info:
+******************************************************************************/
+UDOUBLE ADS1263_Stream_Dropped(ADS1263_STREAM *Stream)
+{
+    return atomic_load_explicit(&Stream->Dropped, memory_order_relaxed);
+}
@@ -0,0 +1,79 @@
+/*****************************************************************************
+* | File        :   ADS1263_Stream.h
+* | Author      :   Waveshare team
+* | Function    :   ADS1263 continuous-conversion streaming
+* | Info        :
+*   An acquisition thread reads every ADC1 conversion and pushes it into
+*   a single-producer/single-consumer ring, the caller drains it in batches.
+*----------------
+* | This version:   V1.0
+* | Date        :   2026-10-14
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef _ADS1263_STREAM_H_
+#define _ADS1263_STREAM_H_
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "ADS1263.h"
+#include "ADS1263_Decim.h"
+
+#define ADS1263_STREAM_MAXCH    11      // single-ended AIN0-AIN10
+
+/**
+ * Streaming state; the ring indices sit on their own cache lines so the
+ * producer and consumer cores do not bounce one line between them
+**/
+typedef struct {
+    ADS1263_SAMPLE *Buf;
+    UDOUBLE Mask;                       // ring size - 1, size is a power of two
+
+    _Alignas(64) atomic_uint Head;      // next slot the producer writes
+    _Alignas(64) atomic_uint Tail;      // next slot the consumer reads
+    _Alignas(64) atomic_uint Dropped;   // conversions lost to a full ring
+    atomic_int Running;
+    _Alignas(64) atomic_ullong Watermark;   // no later sample is stamped before this, see ADS1263_Multi
+
+    pthread_t Thread;
+    ADS1263_DEVICE *Dev;                // device the thread reads
+    UBYTE List[ADS1263_STREAM_MAXCH];
+    UBYTE Number;
+    int CPU;                            // core the thread is pinned to, -1 any
+    ADS1263_DECIM *Decim;               // see ADS1263_Stream_SetDecim, NULL raw samples
+} ADS1263_STREAM;
+
+UBYTE ADS1263_Stream_Init(ADS1263_STREAM *Stream, UDOUBLE Size);
+void ADS1263_Stream_Free(ADS1263_STREAM *Stream);
+
+UBYTE ADS1263_Stream_CheckList(ADS1263_DEVICE *Dev, const UBYTE *List, UBYTE Number);
+UBYTE ADS1263_Stream_Start(ADS1263_STREAM *Stream, ADS1263_DEVICE *Dev, const UBYTE *List, UBYTE Number);
+void ADS1263_Stream_Stop(ADS1263_STREAM *Stream);
+void ADS1263_Stream_SetCPU(ADS1263_STREAM *Stream, int CPU);
+void ADS1263_Stream_SetDecim(ADS1263_STREAM *Stream, ADS1263_DECIM *Decim);
+
+UDOUBLE ADS1263_Stream_Read(ADS1263_STREAM *Stream, ADS1263_SAMPLE *Buf, UDOUBLE Max);
+UDOUBLE ADS1263_Stream_Peek(ADS1263_STREAM *Stream, ADS1263_SAMPLE **Batch);
+void ADS1263_Stream_Release(ADS1263_STREAM *Stream, UDOUBLE Count);
+UDOUBLE ADS1263_Stream_Available(ADS1263_STREAM *Stream);
+UDOUBLE ADS1263_Stream_Dropped(ADS1263_STREAM *Stream);
+
+#endif